@@ -0,0 +1,262 @@
+"""Binding-overhead microbenchmarks.
+
+Each benchmark measures the per-item latency of a binding called once per item
+from Python, and the per-item latency of the same work issued to Skia in a
+single native call (Picture playback or a batched binding). The difference
+approximates the pybind11 dispatch and argument conversion overhead.
+
+Usage::
+
+    python benchmarks/bench_bindings.py --output report.json
+    python benchmarks/bench_bindings.py --filter Canvas --repeat 7
+
+The report is JSON with one entry per benchmark::
+
+    {
+        "name": "Canvas.drawRect",
+        "items": 1000,
+        "python_ns": 812.4,
+        "native_ns": 95.1,
+        "overhead_ns": 717.3,
+        "ratio": 8.54
+    }
+
+``native_ns``, ``overhead_ns``, and ``ratio`` are ``null`` when there is no
+native baseline for the benchmark.
+"""
+import argparse
+import json
+import platform
+import re
+import sys
+import timeit
+
+import numpy as np
+import skia
+
+
+BENCHMARKS = []
+
+
+def benchmark(name):
+    """Registers a benchmark.
+
+    The decorated function takes the item count and returns a tuple of
+    ``(python_fn, native_fn)``; each performs the work for all items, and
+    ``native_fn`` may be ``None``.
+    """
+    def decorator(fn):
+        BENCHMARKS.append((name, fn))
+        return fn
+    return decorator
+
+
+def record(n, draw):
+    recorder = skia.PictureRecorder()
+    canvas = recorder.beginRecording(skia.Rect(256, 256))
+    draw(canvas, n)
+    return recorder.finishRecordingAsPicture()
+
+
+def make_canvas():
+    return skia.Surface(256, 256).getCanvas()
+
+
+def canvas_benchmark(draw):
+    def setup(n):
+        canvas = make_canvas()
+        picture = record(n, draw)
+        return (
+            lambda: draw(canvas, n),
+            lambda: picture.playback(canvas),
+        )
+    return setup
+
+
+def draw_rects(canvas, n):
+    paint = skia.Paint()
+    for i in range(n):
+        canvas.drawRect(skia.Rect(i % 200, 10, i % 200 + 20, 30), paint)
+
+
+def draw_circles(canvas, n):
+    paint = skia.Paint()
+    for i in range(n):
+        canvas.drawCircle(i % 200, 50, 8, paint)
+
+
+def draw_lines(canvas, n):
+    paint = skia.Paint()
+    for i in range(n):
+        canvas.drawLine(i % 200, 0, 200 - i % 200, 100, paint)
+
+
+IMAGE = skia.Image(np.zeros((16, 16, 4), dtype=np.uint8))
+
+
+def draw_images(canvas, n):
+    for i in range(n):
+        canvas.drawImage(IMAGE, i % 200, 20)
+
+
+benchmark('Canvas.drawRect')(canvas_benchmark(draw_rects))
+benchmark('Canvas.drawCircle')(canvas_benchmark(draw_circles))
+benchmark('Canvas.drawLine')(canvas_benchmark(draw_lines))
+benchmark('Canvas.drawImage')(canvas_benchmark(draw_images))
+
+
+@benchmark('Matrix.mapPoints')
+def matrix_map_points(n):
+    matrix = skia.Matrix.MakeScale(2, 3)
+    points = [skia.Point(i, i) for i in range(n)]
+
+    def python_fn():
+        for p in points:
+            matrix.mapPoints([p])
+
+    return python_fn, lambda: matrix.mapPoints(points)
+
+
+@benchmark('Path.lineTo')
+def path_line_to(n):
+    points = [skia.Point(i % 100, i // 100) for i in range(n)]
+
+    def python_fn():
+        path = skia.Path()
+        path.moveTo(0, 0)
+        for p in points:
+            path.lineTo(p)
+
+    def native_fn():
+        path = skia.Path()
+        path.addPoly(points, False)
+
+    return python_fn, native_fn
+
+
+@benchmark('Font.measureText')
+def font_measure_text(n):
+    font = skia.Font()
+    text = 'Hello'
+
+    def python_fn():
+        for _ in range(n):
+            font.measureText(text)
+
+    long_text = text * n
+    return python_fn, lambda: font.measureText(long_text)
+
+
+@benchmark('Image.readPixels')
+def image_read_pixels(n):
+    # n tiles of 16x16 pixels, read one tile per call or all in one call.
+    width = 16 * n
+    image = skia.Image(np.zeros((16, width, 4), dtype=np.uint8))
+    tile_info = skia.ImageInfo.MakeN32Premul(16, 16)
+    tile = bytearray(tile_info.computeMinByteSize())
+    full_info = skia.ImageInfo.MakeN32Premul(width, 16)
+    full = bytearray(full_info.computeMinByteSize())
+
+    def python_fn():
+        for i in range(n):
+            image.readPixels(tile_info, tile, tile_info.minRowBytes(), 16 * i)
+
+    return python_fn, lambda: image.readPixels(
+        full_info, full, full_info.minRowBytes())
+
+
+@benchmark('Data.data')
+def data_buffer_access(n):
+    data = skia.Data(b'\0' * 4096, copy=True)
+
+    def python_fn():
+        for _ in range(n):
+            data.data()
+
+    return python_fn, None
+
+
+@benchmark('Data.__buffer__')
+def data_buffer_protocol(n):
+    data = skia.Data(b'\0' * 4096, copy=True)
+
+    def python_fn():
+        for _ in range(n):
+            memoryview(data)
+
+    return python_fn, None
+
+
+def measure(fn, repeat):
+    """Returns the best wall-clock seconds of a single call to fn."""
+    timer = timeit.Timer(fn)
+    # Same calibration as Timer.autorange, which needs Python 3.6.
+    number = 1
+    while timer.timeit(number) < 0.2:
+        number *= 2
+    return min(timer.repeat(repeat=repeat, number=number)) / number
+
+
+def run(items, repeat, pattern):
+    results = []
+    for name, setup in BENCHMARKS:
+        if pattern and not re.search(pattern, name):
+            continue
+        python_fn, native_fn = setup(items)
+        python_ns = measure(python_fn, repeat) * 1e9 / items
+        native_ns = None
+        if native_fn is not None:
+            native_ns = measure(native_fn, repeat) * 1e9 / items
+        results.append({
+            'name': name,
+            'items': items,
+            'python_ns': python_ns,
+            'native_ns': native_ns,
+            'overhead_ns': (
+                None if native_ns is None else python_ns - native_ns),
+            'ratio': (
+                None if not native_ns else python_ns / native_ns),
+        })
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument(
+        '--items', type=int, default=1000,
+        help='number of items per benchmark (default: %(default)s)')
+    parser.add_argument(
+        '--repeat', type=int, default=5,
+        help='number of timing repetitions; best is reported '
+             '(default: %(default)s)')
+    parser.add_argument(
+        '--filter', default=None,
+        help='regular expression to select benchmarks by name')
+    parser.add_argument(
+        '--output', default=None,
+        help='path to write the JSON report; stdout if omitted')
+    args = parser.parse_args()
+
+    report = {
+        'skia_version': skia.__version__,
+        'python_version': platform.python_version(),
+        'platform': platform.platform(),
+        'results': run(args.items, args.repeat, args.filter),
+    }
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2)
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        sys.stdout.write('\n')
+
+    for result in report['results']:
+        sys.stderr.write('%-24s %10.1f ns %s\n' % (
+            result['name'], result['python_ns'],
+            '' if result['native_ns'] is None else
+            '(native %.1f ns, x%.1f)' % (result['native_ns'], result['ratio'])
+        ))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,88 @@
+"""Import-time benchmark.
+
+Measures the wall-clock time and resident memory of ``import skia`` in fresh
+interpreters, with lazy registration (the default) and with
+``SKIA_PYTHON_EAGER_IMPORT=1``, and the one-off cost of first touching a
+lazily registered group.
+
+Usage::
+
+    python benchmarks/bench_import.py --runs 20 --output report.json
+"""
+import argparse
+import json
+import os
+import platform
+import statistics
+import subprocess
+import sys
+
+
+PROBE = r'''
+import json, resource, sys, time
+before = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+start = time.perf_counter()
+import skia
+imported = time.perf_counter()
+skia.Font, skia.Picture
+touched = time.perf_counter()
+after = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+scale = 1 if sys.platform == 'darwin' else 1024
+json.dump({
+    'import_ms': (imported - start) * 1e3,
+    'first_use_ms': (touched - imported) * 1e3,
+    'rss_kb': (after - before) * scale / 1024,
+}, sys.stdout)
+'''
+
+
+def probe(eager):
+    env = dict(os.environ)
+    env['SKIA_PYTHON_EAGER_IMPORT'] = '1' if eager else '0'
+    output = subprocess.check_output([sys.executable, '-c', PROBE], env=env)
+    return json.loads(output)
+
+
+def run(runs):
+    results = []
+    for mode in ('lazy', 'eager'):
+        samples = [probe(mode == 'eager') for _ in range(runs)]
+        results.append(dict(
+            {'mode': mode, 'runs': runs},
+            **{key: statistics.median(s[key] for s in samples)
+               for key in samples[0]}))
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument(
+        '--runs', type=int, default=10,
+        help='number of fresh interpreters per mode; median is reported '
+             '(default: %(default)s)')
+    parser.add_argument(
+        '--output', default=None,
+        help='path to write the JSON report; stdout if omitted')
+    args = parser.parse_args()
+
+    report = {
+        'python_version': platform.python_version(),
+        'platform': platform.platform(),
+        'results': run(args.runs),
+    }
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2)
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        sys.stdout.write('\n')
+
+    for result in report['results']:
+        sys.stderr.write(
+            '%-6s import %7.1f ms, first use %6.1f ms, %8.0f KB\n' % (
+            result['mode'], result['import_ms'], result['first_use_ms'],
+            result['rss_kb']))
+
+
+if __name__ == '__main__':
+    main()
@@ -14,6 +14,11 @@
 # import sys
 # sys.path.insert(0, os.path.abspath('.'))
 
+import os
+
+# Register all bindings at import so that signatures use Python type names.
+os.environ.setdefault('SKIA_PYTHON_EAGER_IMPORT', '1')
+
 
 # -- Project information -----------------------------------------------------
 
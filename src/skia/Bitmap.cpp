@@ -1,5 +1,11 @@
 #include "common.h"
 #include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
 
 
 py::buffer_info GetPixels(const SkBitmap& bitmap) {
@@ -30,6 +36,181 @@ void* GetBufferPtr(const SkImageInfo& info, py::buffer& b, size_t rowBytes) {
 }
 
 
+bool PixelAllocator::allocPixelRef(SkBitmap* bitmap) {
+    const SkImageInfo info = bitmap->info();
+    size_t rowBytes = bitmap->rowBytes();
+    size_t size = info.computeByteSize(rowBytes);
+    if (SkImageInfo::ByteSizeOverflowed(size))
+        return false;
+    auto allocation = this->allocate(size);
+    if (!allocation.pixels)
+        return false;
+    return bitmap->installPixels(info, allocation.pixels, rowBytes,
+        allocation.release, allocation.context);
+}
+
+namespace {
+
+class HeapPixelAllocator : public PixelAllocator {
+protected:
+    Allocation allocate(size_t size) override {
+        return { sk_malloc_canfail(size), [] (void* pixels, void*) {
+            sk_free(pixels);
+        }, nullptr };
+    }
+};
+
+// Anonymous memory mapping. Pages are zeroed by the system.
+class MappedPixelAllocator : public PixelAllocator {
+public:
+    // hugePages requests transparent huge pages, reducing TLB misses on large
+    // canvases. populate faults all pages in on the calling thread, which
+    // places them on its NUMA node under the default first-touch policy.
+    MappedPixelAllocator(bool hugePages, bool populate)
+        : fHugePages(hugePages), fPopulate(populate) {}
+
+protected:
+    Allocation allocate(size_t size) override {
+#if defined(_WIN32)
+        return { sk_calloc_canfail(size), [] (void* pixels, void*) {
+            sk_free(pixels);
+        }, nullptr };
+#else
+        const size_t kHugePageSize = 2 << 20;
+        size_t mapped = size;
+        if (fHugePages) {
+            if (size > SIZE_MAX - 2 * kHugePageSize)
+                return { nullptr, nullptr, nullptr };
+            // Huge pages can only back aligned 2 MB ranges, so over-allocate
+            // to align the start, and trim the unused ends below.
+            size = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+            mapped = size + kHugePageSize;
+        }
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_POPULATE)
+        // Huge pages are populated after madvise instead, so that neither the
+        // trimmed ends nor small pages are faulted in.
+        if (fPopulate && !fHugePages)
+            flags |= MAP_POPULATE;
+#endif
+        void* mapping = mmap(
+            nullptr, mapped, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (mapping == MAP_FAILED)
+            return { nullptr, nullptr, nullptr };
+        char* pixels = static_cast<char*>(mapping);
+        if (fHugePages) {
+            auto address = reinterpret_cast<uintptr_t>(mapping);
+            auto aligned = (address + kHugePageSize - 1) &
+                ~uintptr_t(kHugePageSize - 1);
+            size_t head = aligned - address;
+            size_t tail = mapped - head - size;
+            pixels += head;
+            if (head)
+                munmap(mapping, head);
+            if (tail)
+                munmap(pixels + size, tail);
+#if defined(MADV_HUGEPAGE)
+            madvise(pixels, size, MADV_HUGEPAGE);
+#endif
+            if (fPopulate) {
+                volatile char* page = pixels;
+                for (size_t i = 0; i < size; i += 4096)
+                    page[i] = 0;
+            }
+        }
+        return { pixels, [] (void* pixels, void* context) {
+            munmap(pixels, reinterpret_cast<size_t>(context));
+        }, reinterpret_cast<void*>(size) };
+#endif
+    }
+
+private:
+    bool fHugePages;
+    bool fPopulate;
+};
+
+// Carves pixels out of large blocks. A block is freed when the allocator has
+// moved on to a new block and all pixels carved from it are released.
+class ArenaPixelAllocator : public PixelAllocator {
+public:
+    explicit ArenaPixelAllocator(size_t blockSize) : fBlockSize(blockSize) {}
+
+protected:
+    struct Block {
+        explicit Block(size_t size)
+            : memory(static_cast<char*>(sk_malloc_canfail(size))),
+              size(size), used(0) {}
+        ~Block() { sk_free(memory); }
+
+        char* memory;
+        size_t size;
+        size_t used;
+    };
+
+    Allocation allocate(size_t size) override {
+        const size_t kAlignment = 64;
+        size = (size + kAlignment - 1) & ~(kAlignment - 1);
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (!fBlock || fBlock->size - fBlock->used < size) {
+            auto block = std::make_shared<Block>(std::max(size, fBlockSize));
+            if (!block->memory)
+                return { nullptr, nullptr, nullptr };
+            fBlock = block;
+        }
+        void* pixels = fBlock->memory + fBlock->used;
+        fBlock->used += size;
+        return { pixels, [] (void*, void* context) {
+            delete static_cast<std::shared_ptr<Block>*>(context);
+        }, new std::shared_ptr<Block>(fBlock) };
+    }
+
+private:
+    size_t fBlockSize;
+    std::mutex fMutex;
+    std::shared_ptr<Block> fBlock;
+};
+
+// Calls a Python factory for each allocation, and keeps the returned buffer
+// exported until the pixels are released.
+class FactoryPixelAllocator : public PixelAllocator {
+public:
+    explicit FactoryPixelAllocator(py::function factory)
+        : fFactory(std::move(factory)) {}
+
+    ~FactoryPixelAllocator() override {
+        py::gil_scoped_acquire acquire;
+        fFactory = py::function();
+    }
+
+protected:
+    Allocation allocate(size_t size) override {
+        py::gil_scoped_acquire acquire;
+        try {
+            py::object owner = fFactory(size);
+            auto info = owner.cast<py::buffer>().request(true);
+            size_t given = (info.ndim) ? info.shape[0] * info.strides[0] : 0;
+            if (given < size)
+                throw py::value_error(
+                    "Buffer from factory is smaller than required.");
+            auto context = new SharedBuffer{owner, std::move(info)};
+            return { context->info.ptr, [] (void*, void* context) {
+                ReleaseSharedBuffer(context);
+            }, context };
+        } catch (std::exception&) {
+            // Allocation failures are reported as failed allocations, as
+            // Skia calls the allocator without exception handling.
+            PyErr_Clear();
+            return { nullptr, nullptr, nullptr };
+        }
+    }
+
+private:
+    py::function fFactory;
+};
+
+}  // namespace
+
+
 void initBitmap(py::module &m) {
 py::enum_<SkTileMode>(m, "TileMode")
     .value("kClamp", SkTileMode::kClamp,
@@ -57,6 +238,90 @@ py::class_<SkPixelRef>(m, "PixelRef",
     // TODO: Implement me!
     ;
 
+py::class_<PixelAllocator, sk_sp<PixelAllocator>, SkRefCnt>(
+    m, "PixelAllocator", R"docstring(
+    :py:class:`PixelAllocator` controls where the pixel memory of
+    :py:class:`Bitmap` and raster :py:class:`Surface` lives.
+
+    Pass an allocator to :py:meth:`Bitmap.allocPixels`,
+    :py:meth:`Bitmap.tryAllocPixels` or :py:meth:`Surface.MakeRaster`::
+
+        allocator = skia.PixelAllocator.MakeHugePage()
+        surface = skia.Surface.MakeRaster(
+            skia.ImageInfo.MakeN32Premul(7680, 4320), allocator=allocator)
+
+    Memory is released when the last :py:class:`Bitmap`, :py:class:`Surface`
+    or :py:class:`Image` sharing the pixels is deleted; the allocator itself
+    may be deleted earlier.
+    )docstring")
+    .def_static("MakeHeap",
+        [] () -> sk_sp<PixelAllocator> {
+            return sk_make_sp<HeapPixelAllocator>();
+        },
+        R"docstring(
+        Returns an allocator of uninitialized memory from the default heap,
+        as Skia allocates by default.
+        )docstring")
+    .def_static("MakeHugePage",
+        [] () -> sk_sp<PixelAllocator> {
+            return sk_make_sp<MappedPixelAllocator>(true, false);
+        },
+        R"docstring(
+        Returns an allocator of zeroed memory mappings backed by transparent
+        huge pages where the platform supports them, reducing TLB pressure on
+        large canvases.
+
+        Sizes are rounded up to 2 MB. Falls back to regular pages when huge
+        pages are unavailable, and to the heap on Windows.
+        )docstring")
+    .def_static("MakeNUMALocal",
+        [] () -> sk_sp<PixelAllocator> {
+            return sk_make_sp<MappedPixelAllocator>(false, true);
+        },
+        R"docstring(
+        Returns an allocator of zeroed memory mappings whose pages are
+        faulted in by the allocating thread.
+
+        Under the default first-touch memory policy, pages are placed on the
+        NUMA node of the allocating thread, so allocate from a thread pinned
+        to the node that renders. Equivalent to :py:meth:`MakeHugePage`
+        without huge pages where pre-faulting is unsupported.
+        )docstring")
+    .def_static("MakeArena",
+        [] (size_t blockSize) -> sk_sp<PixelAllocator> {
+            if (blockSize == 0)
+                throw py::value_error("blockSize must be positive");
+            return sk_make_sp<ArenaPixelAllocator>(blockSize);
+        },
+        R"docstring(
+        Returns an allocator that carves uninitialized pixels out of large
+        blocks, so many small bitmaps share a few heap allocations.
+
+        Each block is freed when the allocator has moved on to a new block
+        and all pixels in it are released; one long-lived bitmap keeps its
+        whole block alive.
+
+        :param int blockSize: bytes per block; larger requests get their own
+            block
+        )docstring",
+        py::arg("blockSize") = 64 << 20)
+    .def_static("MakeFromFactory",
+        [] (py::function factory) -> sk_sp<PixelAllocator> {
+            return sk_make_sp<FactoryPixelAllocator>(factory);
+        },
+        R"docstring(
+        Returns an allocator that calls factory(size) for each allocation.
+
+        factory returns a writable buffer object of at least size bytes, such
+        as a bytearray, NumPy array or :py:class:`mmap.mmap`. The buffer is
+        kept alive until the pixels are released. Errors raised by factory
+        fail the allocation.
+
+        :param Callable[[int], object] factory: buffer factory
+        )docstring",
+        py::arg("factory"))
+    ;
+
 py::class_<SkBitmap> bitmap(m, "Bitmap", py::buffer_protocol(),
     R"docstring(
     :py:class:`Bitmap` describes a two-dimensional raster pixel array.
@@ -86,6 +351,11 @@ py::class_<SkBitmap> bitmap(m, "Bitmap", py::buffer_protocol(),
     :py:class:`Bitmap` is not thread safe. Each thread must have its own copy of
     :py:class:`Bitmap` fields, although threads may share the underlying pixel
     array.
+
+    Pixels are exported without copy through ``__array_interface__`` and
+    DLPack as an array of shape (height, width, channels); see
+    :py:class:`Pixmap`. The buffer protocol, which NumPy prefers, keeps
+    exporting (height, width) packed pixels for compatibility.
     )docstring");
 
 py::enum_<SkBitmap::AllocFlags>(bitmap, "AllocFlags", py::arithmetic())
@@ -95,6 +365,13 @@ py::enum_<SkBitmap::AllocFlags>(bitmap, "AllocFlags", py::arithmetic())
         )docstring")
     .export_values();
 
+DefinePixelExport(bitmap,
+    [] (SkBitmap& self) {
+        if (!self.getPixels())
+            throw std::runtime_error("Bitmap has no pixels.");
+        return self.pixmap();
+    }, false);
+
 bitmap
     .def_buffer(&GetPixels)
     .def(py::init<>(
@@ -518,10 +795,18 @@ bitmap
         )docstring",
         py::arg("info"), py::arg("flags"))
     .def("tryAllocPixels",
-        [] (SkBitmap& bitmap, const SkImageInfo* info, size_t rowBytes) {
-            if (!info)
-                return bitmap.tryAllocPixels();
-            return bitmap.tryAllocPixels(*info, rowBytes);
+        [] (SkBitmap& bitmap, const SkImageInfo* info, size_t rowBytes,
+            PixelAllocator* allocator) {
+            if (!allocator) {
+                if (!info)
+                    return bitmap.tryAllocPixels();
+                return bitmap.tryAllocPixels(*info, rowBytes);
+            }
+            if (info && !bitmap.setInfo(*info, rowBytes)) {
+                bitmap.reset();
+                return false;
+            }
+            return bitmap.tryAllocPixels(allocator);
         },
         R"docstring(
         Sets :py:class:`ImageInfo` to info following the rules in
@@ -539,18 +824,33 @@ bitmap
         until the pixels are written to. The actual behavior depends on the
         platform implementation of :py:meth:`malloc`.
 
+        If info is `None`, uses the current :py:class:`ImageInfo` and row
+        bytes.
+
         :param skia.ImageInfo info: contains width, height,
             :py:class:`AlphaType`, :py:class:`ColorType`, :py:class:`ColorSpace`
         :param int rowBytes: size of pixel row or larger; may be zero
+        :param skia.PixelAllocator allocator: allocator of pixel memory; if
+            `None`, uses the default heap allocator
         :return: true if pixel storage is allocated
         )docstring",
-        py::arg("info") = nullptr, py::arg("rowBytes") = 0)
+        py::arg("info") = nullptr, py::arg("rowBytes") = 0,
+        py::arg("allocator") = nullptr)
     .def("allocPixels",
-        [] (SkBitmap& bitmap, const SkImageInfo* info, size_t rowBytes) {
-            if (!info)
-                bitmap.allocPixels();
-            else
-                bitmap.allocPixels(*info, rowBytes);
+        [] (SkBitmap& bitmap, const SkImageInfo* info, size_t rowBytes,
+            PixelAllocator* allocator) {
+            if (!allocator) {
+                if (!info)
+                    bitmap.allocPixels();
+                else
+                    bitmap.allocPixels(*info, rowBytes);
+                return;
+            }
+            if ((info && !bitmap.setInfo(*info, rowBytes)) ||
+                !bitmap.tryAllocPixels(allocator)) {
+                bitmap.reset();
+                throw std::bad_alloc();
+            }
         },
         R"docstring(
         Sets :py:class:`ImageInfo` to info following the rules in
@@ -569,11 +869,16 @@ bitmap
         until the pixels are written to. The actual behavior depends on the
         platform implementation of :py:meth:`malloc`.
 
+        If an allocator is given, raises MemoryError instead of aborting.
+
         :param skia.ImageInfo info: contains width, height,
             :py:class:`AlphaType`, :py:class:`ColorType`, :py:class:`ColorSpace`
         :param int rowBytes: size of pixel row or larger; may be zero
+        :param skia.PixelAllocator allocator: allocator of pixel memory; if
+            `None`, uses the default heap allocator
         )docstring",
-        py::arg("info") = nullptr, py::arg("rowBytes") = 0)
+        py::arg("info") = nullptr, py::arg("rowBytes") = 0,
+        py::arg("allocator") = nullptr)
     .def("tryAllocN32Pixels", &SkBitmap::tryAllocN32Pixels,
         R"docstring(
         Sets :py:class:`ImageInfo` to width, height, and native color type; and
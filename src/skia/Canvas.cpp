@@ -1,10 +1,270 @@
 #include "common.h"
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <include/svg/SkSVGCanvas.h>
+#include <include/utils/SkPaintFilterCanvas.h>
 
 template<typename T>
 using NumPy = py::array_t<T, py::array::c_style | py::array::forcecast>;
 
+// Draws each row of an (N, columns) float array with a single native paint,
+// optionally overriding the paint color per row. Runs without the GIL.
+template <typename Fn>
+void DrawEach(SkCanvas& canvas, NumPy<float> array, int columns,
+              const SkPaint& paint, py::object colors, Fn&& draw) {
+    if (array.ndim() != 2 || array.shape(1) != columns)
+        throw py::value_error(
+            "Array must have shape (N, " + std::to_string(columns) + ")");
+    auto n = array.shape(0);
+    NumPy<uint32_t> colorArray;
+    if (!colors.is_none()) {
+        colorArray = colors.cast<NumPy<uint32_t>>();
+        if (colorArray.size() != n)
+            throw py::value_error("colors must have N elements");
+    }
+    auto data = array.data();
+    auto colorData = (colors.is_none()) ? nullptr : colorArray.data();
+    py::gil_scoped_release release;
+    SkPaint itemPaint(paint);
+    for (py::ssize_t i = 0; i < n; ++i) {
+        if (colorData)
+            itemPaint.setColor(colorData[i]);
+        draw(canvas, &data[i * columns], itemPaint);
+    }
+}
+
+// Returns an (N, columns) float array, or throws naming the argument.
+NumPy<float> RowArray(py::object object, py::ssize_t n, int columns,
+                      const char* name) {
+    auto array = object.cast<NumPy<float>>();
+    if (array.ndim() != 2 || array.shape(0) != n || array.shape(1) != columns)
+        throw py::value_error(std::string(name) + " must have shape (N, " +
+                              std::to_string(columns) + ")");
+    return array;
+}
+
+// Draws a batch of image rectangles with experimental_DrawEdgeAAImageSet.
+// Geometry is read from NumPy arrays, and the draw runs without the GIL.
+void DrawImageSet(SkCanvas& canvas, py::object images, py::object srcRects,
+                  NumPy<float> dstRects, py::object matrices,
+                  py::object alphas, py::object aaFlags, const SkPaint* paint,
+                  SkCanvas::SrcRectConstraint constraint) {
+    if (dstRects.ndim() != 2 || dstRects.shape(1) != 4)
+        throw py::value_error("dstRects must have shape (N, 4)");
+    auto n = dstRects.shape(0);
+    std::vector<SkCanvas::ImageSetEntry> set(n);
+    if (py::isinstance<SkImage>(images)) {
+        auto image = images.cast<sk_sp<SkImage>>();
+        for (auto& entry : set)
+            entry.fImage = image;
+    } else {
+        auto list = images.cast<std::vector<sk_sp<SkImage>>>();
+        if (static_cast<py::ssize_t>(list.size()) != n)
+            throw py::value_error("images must have N elements");
+        for (py::ssize_t i = 0; i < n; ++i) {
+            if (!list[i])
+                throw py::value_error("images must not contain None");
+            set[i].fImage = std::move(list[i]);
+        }
+    }
+
+    auto dst = dstRects.data();
+    for (py::ssize_t i = 0; i < n; ++i) {
+        set[i].fDstRect = SkRect::MakeLTRB(
+            dst[i * 4], dst[i * 4 + 1], dst[i * 4 + 2], dst[i * 4 + 3]);
+        set[i].fSrcRect = SkRect::Make(set[i].fImage->bounds());
+    }
+    if (!srcRects.is_none()) {
+        auto array = RowArray(srcRects, n, 4, "srcRects");
+        auto src = array.data();
+        for (py::ssize_t i = 0; i < n; ++i)
+            set[i].fSrcRect = SkRect::MakeLTRB(
+                src[i * 4], src[i * 4 + 1], src[i * 4 + 2], src[i * 4 + 3]);
+    }
+    std::vector<SkMatrix> matrixList;
+    if (!matrices.is_none()) {
+        auto array = matrices.cast<NumPy<float>>();
+        if (array.ndim() != 3 || array.shape(0) != n ||
+            array.shape(1) != 3 || array.shape(2) != 3)
+            throw py::value_error("matrices must have shape (N, 3, 3)");
+        auto m = array.data();
+        matrixList.resize(n);
+        for (py::ssize_t i = 0; i < n; ++i, m += 9) {
+            matrixList[i] = SkMatrix::MakeAll(
+                m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]);
+            set[i].fMatrixIndex = i;
+        }
+    }
+    if (!alphas.is_none()) {
+        auto array = alphas.cast<NumPy<float>>();
+        if (array.size() != n)
+            throw py::value_error("alphas must have N elements");
+        auto alpha = array.data();
+        for (py::ssize_t i = 0; i < n; ++i)
+            set[i].fAlpha = alpha[i];
+    }
+    if (py::isinstance<py::array>(aaFlags) ||
+        py::isinstance<py::list>(aaFlags) ||
+        py::isinstance<py::tuple>(aaFlags)) {
+        auto array = aaFlags.cast<NumPy<uint32_t>>();
+        if (array.size() != n)
+            throw py::value_error("aaFlags must have N elements");
+        auto flags = array.data();
+        for (py::ssize_t i = 0; i < n; ++i)
+            set[i].fAAFlags = flags[i];
+    } else {
+        auto flags = py::int_(aaFlags).cast<unsigned>();
+        for (auto& entry : set)
+            entry.fAAFlags = flags;
+    }
+
+    py::gil_scoped_release release;
+    canvas.experimental_DrawEdgeAAImageSet(
+        set.data(), SkToInt(n), nullptr,
+        (matrixList.empty()) ? nullptr : matrixList.data(), paint,
+        constraint);
+}
+
+// Holds the alpha-only surface that OverdrawCanvas counts into when it is not
+// given a canvas by the caller. This is a base class so that the surface is
+// constructed before SkOverdrawCanvas.
+struct OverdrawSurfaceHolder {
+    OverdrawSurfaceHolder() {}
+    OverdrawSurfaceHolder(int width, int height)
+        : fSurface(SkSurface::MakeRaster(SkImageInfo::MakeA8(width, height))) {
+        if (!fSurface)
+            throw std::runtime_error("Failed to create Surface");
+    }
+    sk_sp<SkSurface> fSurface;
+};
+
+class OverdrawCanvas : private OverdrawSurfaceHolder, public SkOverdrawCanvas {
+public:
+    OverdrawCanvas(SkCanvas* canvas)
+        : SkOverdrawCanvas(canvas), fTarget(canvas) {}
+    OverdrawCanvas(int width, int height)
+        : OverdrawSurfaceHolder(width, height),
+          SkOverdrawCanvas(fSurface->getCanvas()),
+          fTarget(fSurface->getCanvas()) {}
+
+    py::array_t<uint8_t> toarray() {
+        auto size = fTarget->getBaseLayerSize();
+        py::array_t<uint8_t> array({size.height(), size.width()});
+        auto info = SkImageInfo::MakeA8(size.width(), size.height());
+        if (!fTarget->readPixels(
+                info, array.mutable_data(), info.minRowBytes(), 0, 0))
+            throw std::runtime_error("Failed to read pixels");
+        return array;
+    }
+
+    py::dict stats() {
+        auto array = toarray();
+        std::vector<int64_t> histogram(256, 0);
+        auto data = array.data();
+        for (py::ssize_t i = 0; i < array.size(); ++i)
+            histogram[data[i]]++;
+        int64_t pixels = array.size();
+        int64_t total = 0;
+        int max = 0;
+        for (int i = 0; i < 256; ++i) {
+            total += i * histogram[i];
+            if (histogram[i])
+                max = i;
+        }
+        py::dict result;
+        result["pixels"] = pixels;
+        result["covered"] = pixels - histogram[0];
+        result["overdrawn"] = pixels - histogram[0] - histogram[1];
+        result["max"] = max;
+        result["mean"] = (pixels) ? double(total) / pixels : 0.0;
+        result["histogram"] = histogram;
+        return result;
+    }
+
+private:
+    SkCanvas* fTarget;
+};
+
+// Forwards to one target of FanOutCanvas under a fixed base matrix, composing
+// an optional color filter into every paint. The target state is restored
+// when the target is removed. The surface owning the target, if any, is
+// referenced so that the target outlives this canvas.
+class FanOutTarget : public SkPaintFilterCanvas {
+public:
+    FanOutTarget(SkCanvas* target, const SkMatrix& matrix,
+                 sk_sp<SkColorFilter> colorFilter)
+        : SkPaintFilterCanvas(target),
+          fSurface(sk_ref_sp(target->getSurface())), fTarget(target),
+          fSaveCount(target->save()), fColorFilter(std::move(colorFilter)) {
+        target->concat(matrix);
+        fBase = target->getTotalMatrix();
+    }
+
+    ~FanOutTarget() override { fTarget->restoreToCount(fSaveCount); }
+
+protected:
+    bool onFilter(SkPaint& paint) const override {
+        if (fColorFilter)
+            paint.setColorFilter(SkColorFilters::Compose(
+                fColorFilter, paint.refColorFilter()));
+        return true;
+    }
+
+    void didSetMatrix(const SkMatrix& matrix) override {
+        fTarget->setMatrix(SkMatrix::Concat(fBase, matrix));
+        SkCanvas::didSetMatrix(matrix);
+    }
+
+    void onClipRegion(const SkRegion& region, SkClipOp op) override {
+        // Region is in device space, which the base matrix does not apply to.
+        SkPath path;
+        region.getBoundaryPath(&path);
+        path.transform(fBase);
+        auto matrix = fTarget->getTotalMatrix();
+        fTarget->resetMatrix();
+        fTarget->clipPath(path, op, true);
+        fTarget->setMatrix(matrix);
+        SkCanvas::onClipRegion(region, op);
+    }
+
+private:
+    sk_sp<SkSurface> fSurface;
+    SkCanvas* fTarget;
+    int fSaveCount;
+    SkMatrix fBase;
+    sk_sp<SkColorFilter> fColorFilter;
+};
+
+// Canvas that replays each call once per target, so that one pass of drawing
+// commands renders several outputs.
+class FanOutCanvas : public SkNWayCanvas {
+public:
+    FanOutCanvas(int width, int height) : SkNWayCanvas(width, height) {}
+
+    ~FanOutCanvas() override { this->removeTargets(); }
+
+    void addTarget(SkCanvas* canvas, const SkMatrix* matrix,
+                   sk_sp<SkColorFilter> colorFilter) {
+        if (this->getSaveCount() != 1 || !this->getTotalMatrix().isIdentity())
+            throw std::runtime_error(
+                "Targets must be added before matrix or clip changes.");
+        fTargets.emplace_back(new FanOutTarget(
+            canvas, (matrix) ? *matrix : SkMatrix::I(),
+            std::move(colorFilter)));
+        this->addCanvas(fTargets.back().get());
+    }
+
+    void removeTargets() {
+        this->removeAll();
+        fTargets.clear();
+    }
+
+    size_t targetCount() const { return fTargets.size(); }
+
+private:
+    std::vector<std::unique_ptr<FanOutTarget>> fTargets;
+};
+
 void initCanvas(py::module &m) {
 py::class_<SkAutoCanvasRestore>(m, "AutoCanvasRestore", R"docstring(
     Stack helper class calls :py:meth:`Canvas.restoreToCount` when
@@ -1444,6 +1704,30 @@ canvas
         :paint: stroke, blend, color, and so on, used to draw
         )docstring",
         py::arg("p0"), py::arg("p1"), py::arg("paint"))
+    .def("drawLines",
+        [] (SkCanvas& canvas, NumPy<float> lines, const SkPaint& paint,
+            py::object colors) {
+            DrawEach(canvas, lines, 4, paint, colors,
+                [] (SkCanvas& c, const float* v, const SkPaint& p) {
+                    c.drawLine(v[0], v[1], v[2], v[3], p);
+                });
+        },
+        R"docstring(
+        Draws N line segments using clip, :py:class:`Matrix`, and
+        :py:class:`Paint` paint, in a single call.
+
+        Equivalent to calling :py:meth:`drawLine` for each row of lines, but
+        without per-call Python overhead. If colors is given, the color of
+        paint is replaced by colors[i] for the i-th segment; other paint
+        settings are shared.
+
+        :param numpy.ndarray lines: (N, 4) array of (x0, y0, x1, y1),
+            converted to float32
+        :param skia.Paint paint: stroke, blend, color, and so on, used to draw
+        :param numpy.ndarray colors: optional (N,) array of
+            :py:class:`Color`, converted to uint32
+        )docstring",
+        py::arg("lines"), py::arg("paint"), py::arg("colors") = py::none())
     .def("drawRect", &SkCanvas::drawRect,
         R"docstring(
         Draws :py:class:`Rect` rect using clip, :py:class:`Matrix`, and
@@ -1459,6 +1743,31 @@ canvas
             to draw
         )docstring",
         py::arg("rect"), py::arg("paint"))
+    .def("drawRects",
+        [] (SkCanvas& canvas, NumPy<float> rects, const SkPaint& paint,
+            py::object colors) {
+            DrawEach(canvas, rects, 4, paint, colors,
+                [] (SkCanvas& c, const float* v, const SkPaint& p) {
+                    c.drawRect(SkRect::MakeLTRB(v[0], v[1], v[2], v[3]), p);
+                });
+        },
+        R"docstring(
+        Draws N rectangles using clip, :py:class:`Matrix`, and
+        :py:class:`Paint` paint, in a single call.
+
+        Equivalent to calling :py:meth:`drawRect` for each row of rects, but
+        without per-call Python overhead. If colors is given, the color of
+        paint is replaced by colors[i] for the i-th rectangle; other paint
+        settings are shared.
+
+        :param numpy.ndarray rects: (N, 4) array of (left, top, right, bottom),
+            converted to float32
+        :param skia.Paint paint: stroke or fill, blend, color, and so on, used
+            to draw
+        :param numpy.ndarray colors: optional (N,) array of
+            :py:class:`Color`, converted to uint32
+        )docstring",
+        py::arg("rects"), py::arg("paint"), py::arg("colors") = py::none())
     .def("drawIRect", &SkCanvas::drawIRect,
         R"docstring(
         Draws :py:class:`IRect` rect using clip, :py:class:`Matrix`, and
@@ -1503,6 +1812,31 @@ canvas
             to draw
         )docstring",
         py::arg("oval"), py::arg("paint"))
+    .def("drawOvals",
+        [] (SkCanvas& canvas, NumPy<float> ovals, const SkPaint& paint,
+            py::object colors) {
+            DrawEach(canvas, ovals, 4, paint, colors,
+                [] (SkCanvas& c, const float* v, const SkPaint& p) {
+                    c.drawOval(SkRect::MakeLTRB(v[0], v[1], v[2], v[3]), p);
+                });
+        },
+        R"docstring(
+        Draws N ovals using clip, :py:class:`Matrix`, and :py:class:`Paint`
+        paint, in a single call.
+
+        Equivalent to calling :py:meth:`drawOval` for each row of ovals, but
+        without per-call Python overhead. If colors is given, the color of
+        paint is replaced by colors[i] for the i-th oval; other paint settings
+        are shared.
+
+        :param numpy.ndarray ovals: (N, 4) array of oval bounds (left, top,
+            right, bottom), converted to float32
+        :param skia.Paint paint: stroke or fill, blend, color, and so on, used
+            to draw
+        :param numpy.ndarray colors: optional (N,) array of
+            :py:class:`Color`, converted to uint32
+        )docstring",
+        py::arg("ovals"), py::arg("paint"), py::arg("colors") = py::none())
     .def("drawRRect", &SkCanvas::drawRRect,
         R"docstring(
         Draws :py:class:`RRect` rrect using clip, :py:class:`Matrix`, and
@@ -1578,6 +1912,31 @@ canvas
             to draw
         )docstring",
         py::arg("center"), py::arg("radius"), py::arg("paint"))
+    .def("drawCircles",
+        [] (SkCanvas& canvas, NumPy<float> circles, const SkPaint& paint,
+            py::object colors) {
+            DrawEach(canvas, circles, 3, paint, colors,
+                [] (SkCanvas& c, const float* v, const SkPaint& p) {
+                    c.drawCircle(v[0], v[1], v[2], p);
+                });
+        },
+        R"docstring(
+        Draws N circles using clip, :py:class:`Matrix`, and :py:class:`Paint`
+        paint, in a single call.
+
+        Equivalent to calling :py:meth:`drawCircle` for each row of circles,
+        but without per-call Python overhead. If colors is given, the color of
+        paint is replaced by colors[i] for the i-th circle; other paint
+        settings are shared.
+
+        :param numpy.ndarray circles: (N, 3) array of (cx, cy, radius),
+            converted to float32
+        :param skia.Paint paint: stroke or fill, blend, color, and so on, used
+            to draw
+        :param numpy.ndarray colors: optional (N,) array of
+            :py:class:`Color`, converted to uint32
+        )docstring",
+        py::arg("circles"), py::arg("paint"), py::arg("colors") = py::none())
     .def("drawArc", &SkCanvas::drawArc,
         R"docstring(
         Draws arc using clip, :py:class:`Matrix`, and :py:class:`Paint` paint.
@@ -2154,7 +2513,8 @@ canvas
             filtering, and so on; may be `None`
         )docstring",
         py::arg("picture"), py::arg("matrix") = nullptr,
-        py::arg("paint") = nullptr)
+        py::arg("paint") = nullptr,
+        py::call_guard<py::gil_scoped_release>())
     // .def("drawPicture",
     //     py::overload_cast<const sk_sp<SkPicture>&, const SkMatrix*,
     //         const SkPaint*>(&SkCanvas::drawPicture),
@@ -2313,6 +2673,43 @@ canvas
         py::arg("atlas"), py::arg("xform"), py::arg("tex"), py::arg("colors"),
         py::arg("mode"), py::arg("cullRect") = nullptr,
         py::arg("paint") = nullptr)
+    .def("drawImageSet", &DrawImageSet,
+        R"docstring(
+        Draws N images, or N rectangles of one image, in a single call.
+
+        Each entry draws srcRects[i] of its image to dstRects[i], transformed
+        by matrices[i] and then by clip and :py:class:`Matrix`, with alpha
+        alphas[i] and edges antialiased per aaFlags[i]. On GPU-backed canvas
+        the set is batched into few draw operations; edges shared by adjacent
+        entries can be left aliased to avoid seams between tiles::
+
+            canvas.drawImageSet(tiles, None, np.array(positions),
+                                aaFlags=skia.Canvas.kNone_QuadAAFlags)
+
+        :param images: list of N :py:class:`Image`, or one :py:class:`Image`
+            shared by all entries, such as an atlas
+        :param numpy.ndarray srcRects: (N, 4) array of (left, top, right,
+            bottom) in image pixels, or `None` for whole images
+        :param numpy.ndarray dstRects: (N, 4) array of (left, top, right,
+            bottom) destination rectangles
+        :param numpy.ndarray matrices: (N, 3, 3) array of row-major matrices
+            applied to dstRects, or `None`
+        :param numpy.ndarray alphas: (N,) array of opacities in [0, 1], or
+            `None` for opaque
+        :param aaFlags: (N,) array of combined :py:class:`Canvas.QuadAAFlags`,
+            or one value for all entries
+        :param Union[skia.Paint,None] paint: :py:class:`ColorFilter`,
+            :py:class:`ImageFilter`, :py:class:`BlendMode`, and so on; may be
+            `None`
+        :param skia.Canvas.SrcRectConstraint constraint: filter strictly
+            within srcRects or draw faster
+        )docstring",
+        py::arg("images"), py::arg("srcRects").none(true),
+        py::arg("dstRects"), py::arg("matrices") = py::none(),
+        py::arg("alphas") = py::none(),
+        py::arg("aaFlags") = SkCanvas::kNone_QuadAAFlags,
+        py::arg("paint") = nullptr, py::arg("constraint") =
+            SkCanvas::SrcRectConstraint::kStrict_SrcRectConstraint)
     // .def("drawAtlas",
     //     py::overload_cast<const sk_sp<SkImage>&, const SkRSXform[],
     //         const SkRect[], const SkColor[], int, SkBlendMode, const SkRect*,
@@ -2507,5 +2904,179 @@ canvas
         py::arg("rowBytes") = 0)
     ;
 
+py::class_<OverdrawCanvas, SkCanvas>(m, "OverdrawCanvas", R"docstring(
+    Captures all drawing commands and, rather than drawing the actual content,
+    increments the alpha channel of each pixel every time it would have been
+    touched by a draw call.
+
+    This is useful for detecting overdraw. The per-pixel counts saturate at
+    255. Use :py:class:`OverdrawColorFilter` to visualize the counts.
+
+    Example::
+
+        canvas = skia.OverdrawCanvas(picture)
+        counts = canvas.toarray()  # (height, width) uint8 array
+        stats = canvas.stats()
+        assert stats['max'] <= 3
+    )docstring")
+    .def(py::init<SkCanvas*>(),
+        R"docstring(
+        Wraps an existing canvas.
+
+        Counts accumulate in the alpha channel of canvas, which should be a
+        raster canvas cleared to transparent, preferably of
+        :py:attr:`ColorType.kAlpha_8_ColorType`.
+
+        :param skia.Canvas canvas: destination of overdraw counts
+        )docstring",
+        py::arg("canvas").none(false), py::keep_alive<1, 2>())
+    .def(py::init<int, int>(),
+        R"docstring(
+        Creates a canvas that counts into an internal alpha-only surface of the
+        specified dimensions.
+
+        :param int width: pixel column count; must be greater than zero
+        :param int height: pixel row count; must be greater than zero
+        )docstring",
+        py::arg("width"), py::arg("height"))
+    .def(py::init(
+        [] (const SkPicture& picture) {
+            auto bounds = picture.cullRect().roundOut();
+            auto canvas = std::unique_ptr<OverdrawCanvas>(
+                new OverdrawCanvas(bounds.width(), bounds.height()));
+            canvas->translate(-bounds.left(), -bounds.top());
+            picture.playback(canvas.get());
+            canvas->resetMatrix();
+            return canvas;
+        }),
+        R"docstring(
+        Creates a canvas sized to the cull :py:class:`Rect` of picture and
+        plays back picture into it.
+
+        :param skia.Picture picture: recorded drawing commands to analyze
+        )docstring",
+        py::arg("picture"))
+    .def("toarray", &OverdrawCanvas::toarray,
+        R"docstring(
+        Returns a copy of the per-pixel overdraw counts.
+
+        :return: NumPy array of dtype = uint8 and dimensions (height, width)
+        :rtype: numpy.ndarray
+        )docstring")
+    .def("stats", &OverdrawCanvas::stats,
+        R"docstring(
+        Returns summary statistics of the per-pixel overdraw counts.
+
+        The returned dict contains ``pixels`` (total pixel count), ``covered``
+        (pixels drawn at least once), ``overdrawn`` (pixels drawn more than
+        once), ``max`` (largest count), ``mean`` (average count over all
+        pixels), and ``histogram`` (list of 256 pixel counts per draw count).
+
+        :rtype: dict
+        )docstring")
+    ;
+
+py::class_<FanOutCanvas, SkCanvas>(m, "FanOutCanvas", R"docstring(
+    Forwards every drawing command to several target canvases, each with its
+    own base :py:class:`Matrix` and optional :py:class:`ColorFilter`.
+
+    One pass of :py:class:`Canvas` calls, or one :py:meth:`Picture.playback`,
+    renders all targets, so commands are decoded and dispatched from Python
+    once instead of once per target::
+
+        canvas = skia.FanOutCanvas(1920, 1080)
+        canvas.addCanvas(full.getCanvas())
+        canvas.addCanvas(thumbnail.getCanvas(), skia.Matrix.Scale(0.25, 0.25))
+        canvas.addCanvas(contrast.getCanvas(),
+                         colorFilter=skia.HighContrastFilter.Make(config))
+        picture.playback(canvas)
+
+    Matrix and clip changes made through :py:class:`FanOutCanvas` are applied
+    to each target after its base matrix. Target canvases are restored to
+    their previous state when removed, and must not be drawn to directly
+    while attached.
+    )docstring")
+    .def(py::init<int, int>(),
+        R"docstring(
+        Creates a canvas without targets.
+
+        :param int width: logical width of the drawing
+        :param int height: logical height of the drawing
+        )docstring",
+        py::arg("width"), py::arg("height"))
+    .def("addCanvas",
+        [] (FanOutCanvas& canvas, SkCanvas* target, const SkMatrix* matrix,
+            const SkColorFilter* colorFilter) {
+            canvas.addTarget(target, matrix, (colorFilter) ?
+                CloneFlattenable<SkColorFilter>(*colorFilter) : nullptr);
+        },
+        R"docstring(
+        Adds a target canvas.
+
+        Targets must be added before any matrix or clip change.
+
+        :param skia.Canvas canvas: target; it and the :py:class:`Surface`
+            that owns it are kept alive until the target is removed
+        :param skia.Matrix matrix: base matrix mapping drawing coordinates to
+            the target, or `None` for identity
+        :param skia.ColorFilter colorFilter: filter composed into the paint of
+            every draw to the target, or `None`
+        )docstring",
+        py::arg("canvas").none(false), py::arg("matrix") = nullptr,
+        py::arg("colorFilter") = nullptr, py::keep_alive<1, 2>())
+    .def("removeAll", &FanOutCanvas::removeTargets,
+        R"docstring(
+        Removes all targets, restoring their state.
+        )docstring")
+    .def("targetCount", &FanOutCanvas::targetCount,
+        R"docstring(
+        Returns the number of targets.
+        )docstring")
+    ;
+
+py::class_<SkSVGCanvas> svgcanvas(m, "SVGCanvas", R"docstring(
+    Factory of :py:class:`Canvas` that translates draw calls to SVG and
+    writes the output to :py:class:`WStream` as the calls are made, without
+    an intermediate DOM.
+
+    The SVG document is finished when the returned canvas is deleted; the
+    stream is kept alive until then::
+
+        with open('output.svg', 'wb') as f:
+            stream = skia.WStream(f)
+            canvas = skia.SVGCanvas.Make(picture.cullRect(), stream)
+            picture.playback(canvas)
+            del canvas
+            stream.flush()
+    )docstring");
+
+svgcanvas
+    .def_static("Make",
+        [] (const SkRect& bounds, SkWStream* stream, uint32_t flags) {
+            auto canvas = SkSVGCanvas::Make(bounds, stream, flags);
+            if (!canvas)
+                throw std::runtime_error("Failed to create SVGCanvas");
+            return canvas;
+        },
+        R"docstring(
+        Returns a new canvas that will generate SVG commands from its draw
+        calls, and send them to the provided stream.
+
+        :param skia.Rect bounds: bounds of the SVG viewport
+        :param skia.WStream stream: destination of the SVG document
+        :param int flags: combination of
+            :py:attr:`~SVGCanvas.kConvertTextToPaths_Flag` and
+            :py:attr:`~SVGCanvas.kNoPrettyXML_Flag`
+        :rtype: skia.Canvas
+        )docstring",
+        py::arg("bounds"), py::arg("stream").none(false),
+        py::arg("flags") = 0, py::keep_alive<0, 2>())
+    ;
+
+svgcanvas.attr("kConvertTextToPaths_Flag") = uint32_t(
+    SkSVGCanvas::kConvertTextToPaths_Flag);
+svgcanvas.attr("kNoPrettyXML_Flag") = uint32_t(
+    SkSVGCanvas::kNoPrettyXML_Flag);
+
     m.def("MakeNullCanvas", &SkMakeNullCanvas);
 }
@@ -1,5 +1,89 @@
 #include "common.h"
 #include <pybind11/operators.h>
+#include <pybind11/numpy.h>
+#include <include/core/SkColorPriv.h>
+#include <include/core/SkUnPreMultiply.h>
+#include <include/private/SkNx.h>
+#include <src/core/SkOpts.h>
+#include <algorithm>
+
+template<typename T>
+using NumPy = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+namespace {
+
+// Arrays smaller than this are converted with the GIL held, since releasing
+// it costs more than the conversion.
+const py::ssize_t kReleaseGILThreshold = 4096;
+
+template <typename Fn>
+void ConvertColors(py::ssize_t n, Fn fn) {
+    if (n < kReleaseGILThreshold) {
+        fn();
+        return;
+    }
+    py::gil_scoped_release release;
+    fn();
+}
+
+std::vector<py::ssize_t> Shape(const py::array& array) {
+    return std::vector<py::ssize_t>(
+        array.shape(), array.shape() + array.ndim());
+}
+
+// Returns the shape of array without its last dimension, which must be
+// channels.
+std::vector<py::ssize_t> PixelShape(
+    const py::array& array, py::ssize_t channels) {
+    auto shape = Shape(array);
+    if (shape.empty() || shape.back() != channels)
+        throw py::value_error(
+            "Last dimension must be " + std::to_string(channels));
+    shape.pop_back();
+    return shape;
+}
+
+// Returns the shape of array with a trailing dimension of channels.
+std::vector<py::ssize_t> ChannelShape(
+    const py::array& array, py::ssize_t channels) {
+    auto shape = Shape(array);
+    shape.push_back(channels);
+    return shape;
+}
+
+// Applies a SkOpts swizzle, which processes several colors per SIMD
+// instruction, to each packed 32-bit color.
+NumPy<uint32_t> SwizzleColors(const NumPy<uint32_t>& colors,
+                              SkOpts::Swizzle_8888_u32 swizzle) {
+    NumPy<uint32_t> result(Shape(colors));
+    auto src = colors.data();
+    auto dst = result.mutable_data();
+    auto n = colors.size();
+    ConvertColors(n, [=] () {
+        const py::ssize_t kChunk = 1 << 30;
+        for (py::ssize_t i = 0; i < n; i += kChunk)
+            swizzle(dst + i, src + i, static_cast<int>(
+                std::min(kChunk, n - i)));
+    });
+    return result;
+}
+
+// Packs (..., 4) RGBA channels into colors; channels are converted to SkColor
+// by fn.
+template <typename T, typename Fn>
+NumPy<uint32_t> PackColors(const NumPy<T>& rgba, Fn fn) {
+    NumPy<uint32_t> result(PixelShape(rgba, 4));
+    auto src = rgba.data();
+    auto dst = result.mutable_data();
+    auto n = result.size();
+    ConvertColors(n, [=] () {
+        for (py::ssize_t i = 0; i < n; ++i)
+            dst[i] = fn(&src[4 * i]);
+    });
+    return result;
+}
+
+}  // namespace
 
 void initColor(py::module &m) {
 py::class_<SkColor4f>(m, "Color4f", R"docstring(
@@ -155,6 +239,184 @@ m.def("PreMultiplyARGB", &SkPreMultiplyARGB,
 m.def("PreMultiplyColor", &SkPreMultiplyColor,
     "Returns pmcolor closest to color c.");
 
+m.def("ColorsToRGBA",
+    [] (const NumPy<uint32_t>& colors) {
+        NumPy<uint8_t> result(ChannelShape(colors, 4));
+        auto src = colors.data();
+        auto dst = result.mutable_data();
+        auto n = colors.size();
+        ConvertColors(n, [=] () {
+            for (py::ssize_t i = 0; i < n; ++i) {
+                dst[4 * i + 0] = SkColorGetR(src[i]);
+                dst[4 * i + 1] = SkColorGetG(src[i]);
+                dst[4 * i + 2] = SkColorGetB(src[i]);
+                dst[4 * i + 3] = SkColorGetA(src[i]);
+            }
+        });
+        return result;
+    },
+    R"docstring(
+    Unpacks an array of colors into 8-bit RGBA components.
+
+    All colors are converted in a single native loop; large arrays are
+    converted without the GIL::
+
+        rgba = skia.ColorsToRGBA(
+            np.array([skia.ColorRED, skia.ColorBLUE], dtype=np.uint32))
+
+    :param numpy.ndarray colors: array of :py:class:`Color`, converted to
+        uint32
+    :return: uint8 array of shape colors.shape + (4,)
+    )docstring",
+    py::arg("colors"));
+m.def("ColorsFromRGBA",
+    [] (py::array rgba) {
+        if (rgba.dtype().kind() == 'f')
+            return PackColors(rgba.cast<NumPy<float>>(),
+                [] (const float* c) {
+                    return SkColor4f{c[0], c[1], c[2], c[3]}.toSkColor();
+                });
+        auto dtype = rgba.dtype();
+        if (dtype.kind() == 'b' ||
+            (dtype.kind() == 'u' && dtype.itemsize() == 1))
+            return PackColors(rgba.cast<NumPy<uint8_t>>(),
+                [] (const uint8_t* c) {
+                    return SkColorSetARGB(c[3], c[0], c[1], c[2]);
+                });
+        auto values = rgba.cast<NumPy<int64_t>>();
+        auto data = values.data();
+        if (std::any_of(data, data + values.size(),
+                        [] (int64_t c) { return c < 0 || c > 255; }))
+            throw py::value_error("Integer components must be in [0, 255]");
+        return PackColors(values,
+            [] (const int64_t* c) {
+                return SkColorSetARGB(c[3], c[0], c[1], c[2]);
+            });
+    },
+    R"docstring(
+    Packs an array of RGBA components into colors.
+
+    Integer components must be in the range [0, 255]. Floating point
+    components are in the range [0, 1] as in :py:class:`Color4f`, and are
+    pinned and rounded to the closest :py:class:`Color`.
+
+    :param numpy.ndarray rgba: array of shape (..., 4)
+    :return: uint32 array of :py:class:`Color` of shape rgba.shape[:-1]
+    :raise: ValueError if the last dimension is not 4, or integer components
+        are out of range
+    )docstring",
+    py::arg("rgba"));
+m.def("ColorsToColor4f",
+    [] (const NumPy<uint32_t>& colors) {
+        NumPy<float> result(ChannelShape(colors, 4));
+        auto src = colors.data();
+        auto dst = reinterpret_cast<SkColor4f*>(result.mutable_data());
+        auto n = colors.size();
+        ConvertColors(n, [=] () {
+            // Same as SkColor4f::FromColor, inlined into the loop.
+            for (py::ssize_t i = 0; i < n; ++i) {
+                auto c = SkNx_cast<float>(Sk4b::Load(&src[i])) * (1 / 255.0f);
+                SkNx_shuffle<2, 1, 0, 3>(c).store(&dst[i]);
+            }
+        });
+        return result;
+    },
+    R"docstring(
+    Converts an array of colors to float RGBA components, equivalent to
+    :py:meth:`Color4f.FromColor` for each color.
+
+    :param numpy.ndarray colors: array of :py:class:`Color`, converted to
+        uint32
+    :return: float32 array of shape colors.shape + (4,)
+    )docstring",
+    py::arg("colors"));
+m.def("PreMultiplyColors",
+    [] (const NumPy<uint32_t>& colors) {
+        // SkColor is BGRA in memory; SkPMColor is BGRA or RGBA.
+#if SK_PMCOLOR_BYTE_ORDER(B,G,R,A)
+        return SwizzleColors(colors, SkOpts::RGBA_to_rgbA);
+#else
+        return SwizzleColors(colors, SkOpts::RGBA_to_bgrA);
+#endif
+    },
+    R"docstring(
+    Returns the pmcolor closest to each color, equivalent to
+    :py:func:`PreMultiplyColor` for each color.
+
+    :param numpy.ndarray colors: array of :py:class:`Color`, converted to
+        uint32
+    :return: uint32 array of premultiplied colors of the same shape
+    )docstring",
+    py::arg("colors"));
+m.def("UnPreMultiplyColors",
+    [] (const NumPy<uint32_t>& pmcolors) {
+#if SK_PMCOLOR_BYTE_ORDER(B,G,R,A)
+        return SwizzleColors(pmcolors, SkOpts::rgbA_to_RGBA);
+#else
+        return SwizzleColors(pmcolors, SkOpts::rgbA_to_BGRA);
+#endif
+    },
+    R"docstring(
+    Returns the unpremultiplied color of each pmcolor.
+
+    Channels are rounded to nearest, and may differ by one from Skia's
+    table-based SkUnPreMultiply::PMColorToColor.
+
+    :param numpy.ndarray pmcolors: array of premultiplied colors, converted
+        to uint32
+    :return: uint32 array of :py:class:`Color` of the same shape
+    )docstring",
+    py::arg("pmcolors"));
+m.def("ColorsToHSV",
+    [] (const NumPy<uint32_t>& colors) {
+        NumPy<float> result(ChannelShape(colors, 3));
+        auto src = colors.data();
+        auto dst = result.mutable_data();
+        auto n = colors.size();
+        ConvertColors(n, [=] () {
+            for (py::ssize_t i = 0; i < n; ++i)
+                SkColorToHSV(src[i], &dst[3 * i]);
+        });
+        return result;
+    },
+    R"docstring(
+    Converts an array of colors to HSV components, equivalent to
+    :py:func:`ColorToHSV` for each color. Alpha is ignored.
+
+    :param numpy.ndarray colors: array of :py:class:`Color`, converted to
+        uint32
+    :return: float32 array of shape colors.shape + (3,) of hue in [0, 360),
+        saturation and value in [0, 1]
+    )docstring",
+    py::arg("colors"));
+m.def("HSVToColors",
+    [] (const NumPy<float>& hsv, const NumPy<uint8_t>& alpha) {
+        NumPy<uint32_t> result(PixelShape(hsv, 3));
+        auto n = result.size();
+        if (alpha.size() != 1 && alpha.size() != n)
+            throw py::value_error(
+                "alpha must be a scalar or have one value per color");
+        auto src = hsv.data();
+        auto a = alpha.data();
+        auto stride = (alpha.size() == 1) ? 0 : 1;
+        auto dst = result.mutable_data();
+        ConvertColors(n, [=] () {
+            for (py::ssize_t i = 0; i < n; ++i)
+                dst[i] = SkHSVToColor(a[stride * i], &src[3 * i]);
+        });
+        return result;
+    },
+    R"docstring(
+    Converts an array of HSV components to colors, equivalent to
+    :py:func:`HSVToColor` for each color. Out of range components are pinned.
+
+    :param numpy.ndarray hsv: array of shape (..., 3), converted to float32
+    :param alpha: alpha of all colors, or array of one alpha per color
+    :return: uint32 array of :py:class:`Color` of shape hsv.shape[:-1]
+    :raise: ValueError
+    )docstring",
+    py::arg("hsv"), py::arg("alpha") = 0xFF);
+
 m.attr("AlphaTRANSPARENT") = SK_AlphaTRANSPARENT;
 m.attr("AlphaOPAQUE") = SK_AlphaOPAQUE;
 m.attr("ColorTRANSPARENT") = SK_ColorTRANSPARENT;
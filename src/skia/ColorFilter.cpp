@@ -117,6 +117,8 @@ colorfilter
         py::arg("data"))
     ;
 
+DefineFlattenablePickle(colorfilter);
+
 py::class_<SkColorMatrix>(m, "ColorMatrix")
     .def(py::init<>())
     // TODO: Implement me!
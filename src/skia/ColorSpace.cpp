@@ -1,4 +1,124 @@
 #include "common.h"
+#include <atomic>
+
+namespace {
+
+bool ToSkcmsPixelFormat(SkColorType colorType, skcms_PixelFormat* format) {
+    switch (colorType) {
+        case kAlpha_8_SkColorType:
+            *format = skcms_PixelFormat_A_8; return true;
+        case kGray_8_SkColorType:
+            *format = skcms_PixelFormat_G_8; return true;
+        case kRGB_565_SkColorType:
+            *format = skcms_PixelFormat_BGR_565; return true;
+        case kARGB_4444_SkColorType:
+            *format = skcms_PixelFormat_ABGR_4444; return true;
+        case kRGBA_8888_SkColorType:
+            *format = skcms_PixelFormat_RGBA_8888; return true;
+        case kBGRA_8888_SkColorType:
+            *format = skcms_PixelFormat_BGRA_8888; return true;
+        case kRGBA_1010102_SkColorType:
+            *format = skcms_PixelFormat_RGBA_1010102; return true;
+        case kRGBA_F16Norm_SkColorType:
+        case kRGBA_F16_SkColorType:
+            *format = skcms_PixelFormat_RGBA_hhhh; return true;
+        case kRGBA_F32_SkColorType:
+            *format = skcms_PixelFormat_RGBA_ffff; return true;
+        case kR16G16B16A16_unorm_SkColorType:
+            *format = skcms_PixelFormat_RGBA_16161616LE; return true;
+        default:
+            return false;
+    }
+}
+
+skcms_AlphaFormat ToSkcmsAlphaFormat(SkAlphaType alphaType) {
+    switch (alphaType) {
+        case kOpaque_SkAlphaType:
+            return skcms_AlphaFormat_Opaque;
+        case kPremul_SkAlphaType:
+            return skcms_AlphaFormat_PremulAsEncoded;
+        default:
+            return skcms_AlphaFormat_Unpremul;
+    }
+}
+
+// Pixels in an untagged ImageInfo are treated as sRGB.
+skcms_ICCProfile ToSkcmsProfile(const SkColorSpace* colorSpace) {
+    skcms_ICCProfile profile;
+    if (colorSpace)
+        colorSpace->toProfile(&profile);
+    else
+        profile = *skcms_sRGB_profile();
+    return profile;
+}
+
+// Images with at least this many pixels are converted on the thread pool, in
+// bands of about this many pixels.
+const size_t kParallelPixels = 1 << 16;
+
+SkPixmap PixmapFromBuffer(
+    const SkImageInfo& info, const py::buffer_info& buffer, size_t rowBytes) {
+    if (rowBytes == 0)
+        rowBytes = info.minRowBytes();
+    if (!info.validRowBytes(rowBytes))
+        throw py::value_error("rowBytes is too small for the image width");
+    size_t size = (buffer.ndim) ? buffer.shape[0] * buffer.strides[0] : 0;
+    if (size < info.computeByteSize(rowBytes))
+        throw std::runtime_error("Buffer is smaller than required.");
+    return SkPixmap(info, buffer.ptr, rowBytes);
+}
+
+// Converts src pixels to the color type, alpha type and color space of dst.
+// src and dst may be the same memory if their pixels and rows are the same
+// size. Requires the GIL, which is released during conversion.
+void ConvertPixels(const SkPixmap& src, const SkPixmap& dst) {
+    if (src.width() != dst.width() || src.height() != dst.height())
+        throw py::value_error("src and dst must have the same dimensions");
+    skcms_PixelFormat srcFormat, dstFormat;
+    if (!ToSkcmsPixelFormat(src.colorType(), &srcFormat) ||
+        !ToSkcmsPixelFormat(dst.colorType(), &dstFormat))
+        throw py::value_error("Unsupported color type");
+    auto srcBegin = static_cast<const char*>(src.addr());
+    auto srcEnd = srcBegin + src.computeByteSize();
+    auto dstBegin = static_cast<const char*>(dst.addr());
+    auto dstEnd = dstBegin + dst.computeByteSize();
+    if (srcBegin < dstEnd && dstBegin < srcEnd &&
+        (srcBegin != dstBegin || src.rowBytes() != dst.rowBytes() ||
+         src.info().bytesPerPixel() != dst.info().bytesPerPixel()))
+        throw py::value_error(
+            "In-place conversion requires the same pixel size and row bytes");
+    auto srcAlpha = ToSkcmsAlphaFormat(src.alphaType());
+    auto dstAlpha = ToSkcmsAlphaFormat(dst.alphaType());
+    auto srcProfile = ToSkcmsProfile(src.colorSpace());
+    auto dstProfile = ToSkcmsProfile(dst.colorSpace());
+
+    size_t width = src.width();
+    size_t height = src.height();
+    size_t rowsPerBand = std::max<size_t>(1, kParallelPixels / width);
+    size_t bands = (height + rowsPerBand - 1) / rowsPerBand;
+    std::atomic<bool> ok(true);
+    auto convertBand = [&] (size_t band) {
+        size_t end = std::min(height, (band + 1) * rowsPerBand);
+        for (size_t y = band * rowsPerBand; y < end; ++y) {
+            if (!skcms_Transform(
+                src.addr(0, y), srcFormat, srcAlpha, &srcProfile,
+                dst.writable_addr(0, y), dstFormat, dstAlpha, &dstProfile,
+                width))
+                ok = false;
+        }
+    };
+    {
+        py::gil_scoped_release release;
+        if (bands > 1)
+            ParallelFor(bands, convertBand);
+        else if (bands == 1)
+            convertBand(0);
+    }
+    if (!ok)
+        throw std::runtime_error("Failed to convert pixels.");
+}
+
+}  // namespace
 
 void initColorSpace(py::module &m) {
 py::class_<SkColorSpace, sk_sp<SkColorSpace>>(m, "ColorSpace")
@@ -54,8 +174,87 @@ py::class_<SkColorSpace, sk_sp<SkColorSpace>>(m, "ColorSpace")
     //     "transformation to XYZ.")
     // .def("Make", &SkColorSpace::Make,
     //     "Create an SkColorSpace from a parsed (skcms) ICC profile.")
+    .def_static("MakeICC",
+        [] (py::buffer b) {
+            auto buffer = b.request();
+            size_t size = (buffer.ndim) ?
+                buffer.shape[0] * buffer.strides[0] : 0;
+            skcms_ICCProfile profile;
+            if (!skcms_Parse(buffer.ptr, size, &profile))
+                throw py::value_error("Invalid ICC profile");
+            auto colorSpace = SkColorSpace::Make(profile);
+            if (!colorSpace)
+                throw py::value_error(
+                    "ICC profile cannot be represented as a ColorSpace");
+            return colorSpace;
+        },
+        R"docstring(
+        Create a :py:class:`ColorSpace` from ICC profile data, such as the
+        profile embedded in a camera image.
+
+        Only RGB profiles with a matrix and parametric transfer functions
+        (or tables close enough to be approximated by them) are supported.
+
+        :param Union[bytes,bytearray,memoryview] data: ICC profile
+        :rtype: skia.ColorSpace
+        :raise: ValueError
+        )docstring",
+        py::arg("data"))
     .def_static("Deserialize", &SkColorSpace::Deserialize)
     .def_static("Equals", &SkColorSpace::Equals,
         "If both are null, we return true.")
     ;
+
+m.def("ConvertPixels",
+    [] (py::buffer src, const SkImageInfo& srcInfo, py::buffer dst,
+        const SkImageInfo& dstInfo, size_t srcRowBytes, size_t dstRowBytes) {
+        auto srcBuffer = src.request();
+        auto dstBuffer = dst.request(true);
+        ConvertPixels(
+            PixmapFromBuffer(srcInfo, srcBuffer, srcRowBytes),
+            PixmapFromBuffer(dstInfo, dstBuffer, dstRowBytes));
+    },
+    R"docstring(
+    Converts pixels from srcInfo to the :py:class:`ColorType`,
+    :py:class:`AlphaType` and :py:class:`ColorSpace` of dstInfo, without
+    creating intermediate images.
+
+    src and dst may be the same buffer if both formats have the same pixel
+    size, which converts in place::
+
+        info = skia.ImageInfo.MakeN32Premul(width, height,
+            skia.ColorSpace.MakeICC(profile))
+        skia.ConvertPixels(array, info, array,
+            info.makeColorSpace(skia.ColorSpace.MakeSRGB()))
+
+    Pixels are in sRGB if the :py:class:`ColorSpace` of an info is `None`.
+    The GIL is released, and large images are converted in parallel on a
+    native thread pool.
+
+    :param src: buffer of source pixels, such as a NumPy array
+    :param skia.ImageInfo srcInfo: source pixel format and dimensions
+    :param dst: writable buffer of destination pixels
+    :param skia.ImageInfo dstInfo: destination pixel format; dimensions must
+        match srcInfo
+    :param int srcRowBytes: source row bytes; 0 for srcInfo.minRowBytes()
+    :param int dstRowBytes: destination row bytes; 0 for
+        dstInfo.minRowBytes()
+    :raise: ValueError, RuntimeError
+    )docstring",
+    py::arg("src"), py::arg("srcInfo"), py::arg("dst"), py::arg("dstInfo"),
+    py::arg("srcRowBytes") = 0, py::arg("dstRowBytes") = 0);
+m.def("ConvertPixels",
+    [] (const SkPixmap& src, const SkPixmap& dst) {
+        ConvertPixels(src, dst);
+    },
+    R"docstring(
+    Converts pixels of src to the :py:class:`ColorType`,
+    :py:class:`AlphaType` and :py:class:`ColorSpace` of dst.
+
+    :param skia.Pixmap src: source pixels
+    :param skia.Pixmap dst: destination pixels; may be the same memory as
+        src if both formats have the same pixel size
+    :raise: ValueError, RuntimeError
+    )docstring",
+    py::arg("src"), py::arg("dst"));
 }
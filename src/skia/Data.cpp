@@ -15,6 +15,24 @@ py::buffer_info GetBuffer(SkData &d, bool readonly = true) {
 template<>
 struct py::detail::has_operator_delete<SkData, void> : std::false_type {};
 
+sk_sp<SkData> DataFromBuffer(py::buffer b) {
+    auto info = new py::buffer_info(b.request());
+    size_t size = (info->ndim) ? info->shape[0] * info->strides[0] : 0;
+    return SkData::MakeWithProc(info->ptr, size,
+        [] (const void*, void* context) {
+            py::gil_scoped_acquire acquire;
+            delete static_cast<py::buffer_info*>(context);
+        }, info);
+}
+
+py::object PickleData(sk_sp<SkData> data, int protocol) {
+    if (!data)
+        throw std::runtime_error("Failed to serialize");
+    if (protocol >= 5)
+        return py::module::import("pickle").attr("PickleBuffer")(data);
+    return py::bytes(static_cast<const char*>(data->data()), data->size());
+}
+
 void initData(py::module &m) {
 py::class_<SkData, sk_sp<SkData>>(m, "Data", py::buffer_protocol(),
     R"docstring(
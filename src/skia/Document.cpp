@@ -0,0 +1,215 @@
+#include "common.h"
+#include <include/core/SkDocument.h>
+#include <include/core/SkExecutor.h>
+#include <include/docs/SkPDFDocument.h>
+
+namespace {
+
+// Pool of PDF backend jobs. endPage and close hold the GIL while waiting for
+// these jobs, so they must not share AsyncExecutor, whose workers may be
+// waiting for the GIL.
+SkExecutor& PDFExecutor() {
+    static std::unique_ptr<SkExecutor> executor =
+        SkExecutor::MakeFIFOThreadPool();
+    return *executor;
+}
+
+}  // namespace
+
+void initDocument(py::module &m) {
+py::class_<SkDocument, sk_sp<SkDocument>, SkRefCnt> document(
+    m, "Document", R"docstring(
+    High-level API for creating a document-based canvas.
+
+    To use:
+
+    1. Create a document, e.g. :py:meth:`PDF.MakeDocument`.
+    2. For each page of content:
+
+       a. canvas = doc.beginPage(...)
+       b. draw stuff on canvas
+       c. doc.endPage()
+
+    3. Close the document with doc.close().
+
+    :py:class:`Document` supports the context manager protocol, closing the
+    document on exit::
+
+        with skia.PDF.MakeDocument(stream) as document:
+            canvas = document.beginPage(612, 792)
+            canvas.drawCircle(306, 396, 100, paint)
+            document.endPage()
+    )docstring");
+
+document
+    .def("beginPage", &SkDocument::beginPage,
+        R"docstring(
+        Begin a new page for the document, returning the canvas that will draw
+        into the page.
+
+        The document owns this canvas, and it will go out of scope when
+        :py:meth:`endPage` or :py:meth:`close` is called, or the document is
+        deleted.
+
+        :param float width: page width in points
+        :param float height: page height in points
+        :param skia.Rect content: area of the page to draw into; may be `None`
+        :return: :py:class:`Canvas` of the page, or `None`
+        )docstring",
+        py::arg("width"), py::arg("height"), py::arg("content") = nullptr,
+        py::return_value_policy::reference)
+    .def("endPage", &SkDocument::endPage,
+        R"docstring(
+        Call :py:meth:`endPage` when the content for the current page has been
+        drawn (into the canvas returned by :py:meth:`beginPage`).
+
+        After this call the canvas returned by :py:meth:`beginPage` will be
+        out-of-scope.
+        )docstring")
+    .def("close", &SkDocument::close,
+        R"docstring(
+        Call :py:meth:`close` when all pages have been drawn.
+
+        This will close the file or stream holding the document's contents.
+        After :py:meth:`close` the document can no longer add new pages.
+        Deleting the document will automatically call :py:meth:`close` if
+        need be.
+        )docstring")
+    .def("abort", &SkDocument::abort,
+        R"docstring(
+        Call :py:meth:`abort` to stop producing the document immediately.
+
+        The stream output must be ignored, and should not be trusted.
+        )docstring")
+    .def("__enter__", [] (SkDocument& self) { return &self; },
+        py::return_value_policy::reference)
+    .def("__exit__",
+        [] (SkDocument& self, py::object excType, py::object, py::object) {
+            // Do not finish a document whose drawing raised.
+            if (excType.is_none())
+                self.close();
+            else
+                self.abort();
+        })
+    ;
+
+py::module pdf = m.def_submodule("PDF", R"docstring(
+    PDF document backend.
+    )docstring");
+
+py::class_<SkPDF::Metadata>(pdf, "Metadata", R"docstring(
+    Optional metadata to be passed into the PDF factory function.
+    )docstring")
+    .def(py::init<>())
+    .def_property("fTitle",
+        [] (const SkPDF::Metadata& self) { return self.fTitle.c_str(); },
+        [] (SkPDF::Metadata& self, const std::string& value) {
+            self.fTitle.set(value.c_str());
+        },
+        "The document's title.")
+    .def_property("fAuthor",
+        [] (const SkPDF::Metadata& self) { return self.fAuthor.c_str(); },
+        [] (SkPDF::Metadata& self, const std::string& value) {
+            self.fAuthor.set(value.c_str());
+        },
+        "The name of the person who created the document.")
+    .def_property("fSubject",
+        [] (const SkPDF::Metadata& self) { return self.fSubject.c_str(); },
+        [] (SkPDF::Metadata& self, const std::string& value) {
+            self.fSubject.set(value.c_str());
+        },
+        "The subject of the document.")
+    .def_property("fKeywords",
+        [] (const SkPDF::Metadata& self) { return self.fKeywords.c_str(); },
+        [] (SkPDF::Metadata& self, const std::string& value) {
+            self.fKeywords.set(value.c_str());
+        },
+        "Keywords associated with the document.")
+    .def_property("fCreator",
+        [] (const SkPDF::Metadata& self) { return self.fCreator.c_str(); },
+        [] (SkPDF::Metadata& self, const std::string& value) {
+            self.fCreator.set(value.c_str());
+        },
+        R"docstring(
+        If the document was converted to PDF from another format, the name of
+        the conforming product that created the original document from which
+        it was converted.
+        )docstring")
+    .def_property("fProducer",
+        [] (const SkPDF::Metadata& self) { return self.fProducer.c_str(); },
+        [] (SkPDF::Metadata& self, const std::string& value) {
+            self.fProducer.set(value.c_str());
+        },
+        R"docstring(
+        The product that is converting this document to PDF.
+        )docstring")
+    // .def_readwrite("fCreation", &SkPDF::Metadata::fCreation)
+    // .def_readwrite("fModified", &SkPDF::Metadata::fModified)
+    .def_readwrite("fRasterDPI", &SkPDF::Metadata::fRasterDPI,
+        R"docstring(
+        The DPI (pixels-per-inch) at which features without native PDF support
+        will be rasterized (e.g. draw image with perspective, draw text with
+        perspective, ...) A larger DPI would create a PDF that reflects the
+        original intent with better fidelity, but it can make for larger PDF
+        files too, which would use more memory while rendering, and it would
+        be slower to be processed or sent online or to printer.
+        )docstring")
+    .def_readwrite("fPDFA", &SkPDF::Metadata::fPDFA,
+        R"docstring(
+        If true, include XMP metadata, a document UUID, and sRGB output intent
+        information. This adds length to the document and makes it
+        non-reproducable, but are necessary features for PDF/A-2b conformance
+        )docstring")
+    .def_readwrite("fEncodingQuality", &SkPDF::Metadata::fEncodingQuality,
+        R"docstring(
+        Encoding quality controls the trade-off between size and quality. By
+        default this is set to 101 percent, which corresponds to lossless
+        encoding. If this value is set to a value <= 100, and the image is
+        opaque, it will be encoded (using JPEG) with that quality setting.
+        )docstring")
+    .def_property("fExecutor",
+        [] (const SkPDF::Metadata& self) { return self.fExecutor != nullptr; },
+        [] (SkPDF::Metadata& self, bool value) {
+            self.fExecutor = (value) ? &PDFExecutor() : nullptr;
+        },
+        R"docstring(
+        If true, image encoding and font subsetting run in parallel on a
+        native thread pool, and the document is assembled in the original
+        order. Output is identical to serial output.
+        )docstring")
+    ;
+
+pdf.def("MakeDocument",
+    [] (SkWStream* stream, const SkPDF::Metadata& metadata) {
+        auto document = SkPDF::MakeDocument(stream, metadata);
+        if (!document)
+            throw std::runtime_error("Failed to create PDF document");
+        return document;
+    },
+    R"docstring(
+    Creates a PDF-backed document, writing the results into a
+    :py:class:`WStream`.
+
+    PDF pages are sized in point units. 1 pt == 1/72 inch == 127/360 mm.
+    Pages are written to stream as they are ended, so long documents are not
+    held in memory::
+
+        with open('report.pdf', 'wb') as f:
+            stream = skia.WStream(f)
+            metadata = skia.PDF.Metadata()
+            metadata.fTitle = 'Report'
+            metadata.fExecutor = True
+            with skia.PDF.MakeDocument(stream, metadata) as document:
+                for page in pages:
+                    canvas = document.beginPage(612, 792)
+                    page.draw(canvas)
+                    document.endPage()
+
+    :param skia.WStream stream: a :py:class:`WStream` to write the PDF to;
+        kept alive while the document exists
+    :param skia.PDF.Metadata metadata: a PDFmetadata object
+    :return: :py:class:`Document`
+    )docstring",
+    py::arg("stream").none(false), py::arg("metadata") = SkPDF::Metadata(),
+    py::keep_alive<0, 1>());
+}
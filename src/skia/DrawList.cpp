@@ -0,0 +1,268 @@
+#include "common.h"
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+template<typename T>
+using NumPy = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+// Compact command buffer that replays many primitive draws in a single native
+// loop. All inputs are validated and copied at construction, so draw() never
+// touches Python objects and can run without the GIL.
+class DrawList {
+public:
+    enum Op : uint8_t {
+        kRect_Op,
+        kOval_Op,
+        kCircle_Op,
+        kLine_Op,
+        kPoint_Op,
+        kImage_Op,
+        kImageRect_Op,
+        kLast_Op = kImageRect_Op,
+    };
+
+    // Layout of a single command in the packed bytes format.
+    struct PackedCommand {
+        uint8_t op;
+        uint8_t reserved[3];
+        int32_t paintIndex;
+        int32_t imageIndex;
+        float coords[4];
+    };
+    static_assert(sizeof(PackedCommand) == 28, "Unexpected padding");
+
+    DrawList(std::vector<SkPaint> paints, std::vector<sk_sp<SkImage>> images)
+        : fPaints(std::move(paints)), fImages(std::move(images)) {}
+
+    void append(uint8_t op, int32_t paintIndex, int32_t imageIndex,
+                const float coords[4]) {
+        if (op > kLast_Op)
+            throw py::value_error("Invalid op code");
+        if (paintIndex < -1 || paintIndex >= int32_t(fPaints.size()))
+            throw py::index_error("Paint index out of range");
+        if (op == kImage_Op || op == kImageRect_Op) {
+            if (imageIndex < 0 || imageIndex >= int32_t(fImages.size()))
+                throw py::index_error("Image index out of range");
+        }
+        fOps.push_back(op);
+        fPaintIndices.push_back(paintIndex);
+        fImageIndices.push_back(imageIndex);
+        fCoords.push_back(
+            SkRect::MakeLTRB(coords[0], coords[1], coords[2], coords[3]));
+    }
+
+    size_t size() const { return fOps.size(); }
+
+    void draw(SkCanvas* canvas) const {
+        SkPaint defaultPaint;
+        for (size_t i = 0; i < fOps.size(); ++i) {
+            const SkRect& r = fCoords[i];
+            const SkPaint* paint = (fPaintIndices[i] < 0) ?
+                nullptr : &fPaints[fPaintIndices[i]];
+            const SkPaint& p = (paint) ? *paint : defaultPaint;
+            switch (fOps[i]) {
+                case kRect_Op:
+                    canvas->drawRect(r, p);
+                    break;
+                case kOval_Op:
+                    canvas->drawOval(r, p);
+                    break;
+                case kCircle_Op:
+                    canvas->drawCircle(r.fLeft, r.fTop, r.fRight, p);
+                    break;
+                case kLine_Op:
+                    canvas->drawLine(r.fLeft, r.fTop, r.fRight, r.fBottom, p);
+                    break;
+                case kPoint_Op:
+                    canvas->drawPoint(r.fLeft, r.fTop, p);
+                    break;
+                case kImage_Op:
+                    canvas->drawImage(
+                        fImages[fImageIndices[i]], r.fLeft, r.fTop, paint);
+                    break;
+                case kImageRect_Op:
+                    canvas->drawImageRect(
+                        fImages[fImageIndices[i]], r, paint);
+                    break;
+            }
+        }
+    }
+
+private:
+    std::vector<uint8_t> fOps;
+    std::vector<int32_t> fPaintIndices;
+    std::vector<int32_t> fImageIndices;
+    std::vector<SkRect> fCoords;
+    std::vector<SkPaint> fPaints;
+    std::vector<sk_sp<SkImage>> fImages;
+};
+
+void initDrawList(py::module &m) {
+py::class_<DrawList> drawlist(m, "DrawList", R"docstring(
+    :py:class:`DrawList` is a compact command buffer of primitive draws that is
+    replayed to :py:class:`Canvas` in a single native call.
+
+    Commands are described by structure-of-arrays: an op code, a paint index,
+    an image index, and four coordinates per command. The meaning of the
+    coordinates depends on the op:
+
+    ======================================  ===============================
+    op                                      coords
+    ======================================  ===============================
+    :py:attr:`~DrawList.Op.kRect_Op`        left, top, right, bottom
+    :py:attr:`~DrawList.Op.kOval_Op`        left, top, right, bottom
+    :py:attr:`~DrawList.Op.kCircle_Op`      cx, cy, radius, (unused)
+    :py:attr:`~DrawList.Op.kLine_Op`        x0, y0, x1, y1
+    :py:attr:`~DrawList.Op.kPoint_Op`       x, y, (unused), (unused)
+    :py:attr:`~DrawList.Op.kImage_Op`       left, top, (unused), (unused)
+    :py:attr:`~DrawList.Op.kImageRect_Op`   left, top, right, bottom
+    ======================================  ===============================
+
+    A paint index of -1 draws with the default :py:class:`Paint`, or without
+    paint for image ops. Image indices are ignored by non-image ops.
+
+    All arrays, paints and images are copied at construction, so a
+    :py:class:`DrawList` can be drawn repeatedly and is unaffected by later
+    changes to the inputs. :py:meth:`draw` releases the GIL.
+
+    Example::
+
+        red, blue = skia.Paint(), skia.Paint()
+        red.setColor(skia.ColorRED)
+        blue.setColor(skia.ColorBLUE)
+        ops = np.full(n, skia.DrawList.kCircle_Op, dtype=np.uint8)
+        coords = np.random.rand(n, 4).astype(np.float32) * 100
+        paintIndices = np.random.randint(0, 2, n, dtype=np.int32)
+        drawlist = skia.DrawList(ops, coords, paintIndices, [red, blue])
+        drawlist.draw(canvas)
+
+    .. rubric:: Classes
+
+    .. autosummary::
+        :nosignatures:
+
+        ~DrawList.Op
+    )docstring");
+
+py::enum_<DrawList::Op>(drawlist, "Op")
+    .value("kRect_Op", DrawList::Op::kRect_Op)
+    .value("kOval_Op", DrawList::Op::kOval_Op)
+    .value("kCircle_Op", DrawList::Op::kCircle_Op)
+    .value("kLine_Op", DrawList::Op::kLine_Op)
+    .value("kPoint_Op", DrawList::Op::kPoint_Op)
+    .value("kImage_Op", DrawList::Op::kImage_Op)
+    .value("kImageRect_Op", DrawList::Op::kImageRect_Op)
+    .value("kLast_Op", DrawList::Op::kLast_Op)
+    .export_values();
+
+drawlist
+    .def(py::init(
+        [] (NumPy<uint8_t> ops, NumPy<float> coords,
+            py::object paintIndices, const std::vector<SkPaint>& paints,
+            py::object imageIndices,
+            const std::vector<sk_sp<SkImage>>& images) {
+            auto n = ops.size();
+            if (coords.ndim() != 2 || coords.shape(0) != n ||
+                coords.shape(1) != 4)
+                throw py::value_error("coords must have shape (N, 4)");
+            NumPy<int32_t> paintArray = (paintIndices.is_none()) ?
+                NumPy<int32_t>(n) : paintIndices.cast<NumPy<int32_t>>();
+            NumPy<int32_t> imageArray = (imageIndices.is_none()) ?
+                NumPy<int32_t>(n) : imageIndices.cast<NumPy<int32_t>>();
+            if (paintIndices.is_none())
+                std::fill_n(
+                    paintArray.mutable_data(), n, (paints.empty()) ? -1 : 0);
+            if (imageIndices.is_none())
+                std::fill_n(imageArray.mutable_data(), n, 0);
+            if (paintArray.size() != n || imageArray.size() != n)
+                throw py::value_error(
+                    "paintIndices and imageIndices must have N elements");
+            std::unique_ptr<DrawList> drawlist(new DrawList(paints, images));
+            auto op = ops.data();
+            auto coord = coords.data();
+            auto paintIndex = paintArray.data();
+            auto imageIndex = imageArray.data();
+            for (py::ssize_t i = 0; i < n; ++i)
+                drawlist->append(
+                    op[i], paintIndex[i], imageIndex[i], &coord[4 * i]);
+            return drawlist;
+        }),
+        R"docstring(
+        Creates :py:class:`DrawList` from NumPy arrays.
+
+        :param numpy.ndarray ops: (N,) array of :py:class:`DrawList.Op` codes,
+            converted to uint8
+        :param numpy.ndarray coords: (N, 4) array of coordinates, converted to
+            float32
+        :param numpy.ndarray paintIndices: (N,) array of indices into paints,
+            converted to int32; if `None`, all commands use paints[0], or the
+            default paint when paints is empty
+        :param List[skia.Paint] paints: paints referenced by paintIndices
+        :param numpy.ndarray imageIndices: (N,) array of indices into images,
+            converted to int32; if `None`, all commands use images[0]
+        :param List[skia.Image] images: images referenced by imageIndices
+        :raise: ValueError, IndexError
+        )docstring",
+        py::arg("ops"), py::arg("coords"), py::arg("paintIndices") = py::none(),
+        py::arg("paints") = std::vector<SkPaint>(),
+        py::arg("imageIndices") = py::none(),
+        py::arg("images") = std::vector<sk_sp<SkImage>>())
+    .def_static("FromBytes",
+        [] (py::buffer b, const std::vector<SkPaint>& paints,
+            const std::vector<sk_sp<SkImage>>& images) {
+            py::buffer_info info = b.request();
+            size_t length = (info.ndim) ? info.strides[0] * info.shape[0] : 0;
+            if (length % sizeof(DrawList::PackedCommand))
+                throw py::value_error(
+                    "Buffer size must be a multiple of 28 bytes");
+            std::unique_ptr<DrawList> drawlist(new DrawList(paints, images));
+            auto commands = static_cast<const DrawList::PackedCommand*>(
+                info.ptr);
+            for (size_t i = 0; i < length / sizeof(DrawList::PackedCommand);
+                 ++i) {
+                DrawList::PackedCommand command;
+                memcpy(&command, &commands[i], sizeof(command));
+                drawlist->append(command.op, command.paintIndex,
+                    command.imageIndex, command.coords);
+            }
+            return drawlist;
+        },
+        R"docstring(
+        Creates :py:class:`DrawList` from packed bytes.
+
+        Each command is a 28-byte record in native byte order, equivalent to
+        the C struct::
+
+            struct {
+                uint8_t op;
+                uint8_t reserved[3];
+                int32_t paintIndex;
+                int32_t imageIndex;
+                float coords[4];
+            };
+
+        or the NumPy dtype ``[('op', 'u1'), ('reserved', 'u1', 3),
+        ('paintIndex', 'i4'), ('imageIndex', 'i4'), ('coords', 'f4', 4)]``.
+
+        :param Union[bytes,bytearray,memoryview] data: packed commands
+        :param List[skia.Paint] paints: paints referenced by paintIndex
+        :param List[skia.Image] images: images referenced by imageIndex
+        :raise: ValueError, IndexError
+        )docstring",
+        py::arg("data"), py::arg("paints") = std::vector<SkPaint>(),
+        py::arg("images") = std::vector<sk_sp<SkImage>>())
+    .def("draw",
+        [] (const DrawList& drawlist, SkCanvas* canvas) {
+            py::gil_scoped_release release;
+            drawlist.draw(canvas);
+        },
+        R"docstring(
+        Draws all commands to canvas in order, using clip and
+        :py:class:`Matrix` of canvas.
+
+        :param skia.Canvas canvas: receiver of drawing commands
+        )docstring",
+        py::arg("canvas").none(false))
+    .def("__len__", &DrawList::size)
+    ;
+}
@@ -0,0 +1,122 @@
+#include "common.h"
+#include <include/core/SkExecutor.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+SkExecutor& AsyncExecutor() {
+    // Never destroyed: joining workers during static destruction would run
+    // after the interpreter is finalized.
+    static SkExecutor* executor = SkExecutor::MakeFIFOThreadPool().release();
+    return *executor;
+}
+
+namespace {
+
+// Number of asynchronous calls whose context is not resolved yet.
+std::mutex gPendingMutex;
+std::condition_variable gPendingDone;
+size_t gPending = 0;
+
+// atexit hook that waits for pending calls while the interpreter is still
+// alive. Called with the GIL held, which workers need to finish.
+void WaitForPendingAsync() {
+    py::gil_scoped_release release;
+    std::unique_lock<std::mutex> lock(gPendingMutex);
+    gPendingDone.wait(lock, [] () { return gPending == 0; });
+}
+
+}  // namespace
+
+AsyncContext* MakeAsyncContext() {
+    static bool registered = (py::module::import("atexit").attr("register")(
+        py::cpp_function(&WaitForPendingAsync)), true);
+    (void) registered;
+    auto asyncio = py::module::import("asyncio");
+    // get_running_loop is new in Python 3.7; _get_running_loop returns None
+    // instead of raising outside a running loop.
+    py::object loop = py::none();
+    if (py::hasattr(asyncio, "get_running_loop")) {
+        try {
+            loop = asyncio.attr("get_running_loop")();
+        } catch (py::error_already_set&) {
+            // No running loop.
+        }
+    } else if (py::hasattr(asyncio, "_get_running_loop")) {
+        loop = asyncio.attr("_get_running_loop")();
+    }
+    if (loop.is_none())
+        throw std::runtime_error(
+            "Async methods must be called from a coroutine running in an "
+            "asyncio event loop.");
+    std::unique_ptr<AsyncContext> context(
+        new AsyncContext{loop, loop.attr("create_future")()});
+    std::lock_guard<std::mutex> lock(gPendingMutex);
+    ++gPending;
+    return context.release();
+}
+
+void EndAsync() {
+    std::lock_guard<std::mutex> lock(gPendingMutex);
+    if (--gPending == 0)
+        gPendingDone.notify_all();
+}
+
+void ResolveAsync(
+    AsyncContext* context, py::object result, const std::string& error) {
+    std::unique_ptr<AsyncContext> owner(context);
+    py::object future = context->future;
+    py::cpp_function resolve([future, result, error] () {
+        if (future.attr("done")().cast<bool>())
+            return;
+        if (error.empty())
+            future.attr("set_result")(result);
+        else
+            future.attr("set_exception")(
+                py::reinterpret_borrow<py::object>(PyExc_RuntimeError)(error));
+    });
+    try {
+        context->loop.attr("call_soon_threadsafe")(resolve);
+    } catch (py::error_already_set&) {
+        // The loop is closed; nobody is waiting for the result.
+    }
+}
+
+void ParallelFor(size_t count, std::function<void(size_t)> fn) {
+    struct State {
+        std::atomic<size_t> next;
+        std::atomic<size_t> done;
+        size_t count;
+        std::function<void(size_t)> fn;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<State>();
+    state->next = 0;
+    state->done = 0;
+    state->count = count;
+    state->fn = std::move(fn);
+    // Workers that start after all items are claimed return immediately, so
+    // the caller never waits for tasks still queued behind other work.
+    auto run = [state] () {
+        size_t i;
+        while ((i = state->next++) < state->count) {
+            state->fn(i);
+            if (++state->done == state->count) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+    size_t workers = std::min<size_t>(
+        count, std::max(1u, std::thread::hardware_concurrency()));
+    for (size_t i = 1; i < workers; ++i)
+        AsyncExecutor().add(run);
+    run();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state] () {
+        return state->done == state->count;
+    });
+}
@@ -6,8 +6,8 @@ using NumPy = py::array_t<T, py::array::c_style | py::array::forcecast>;
 
 
 void* GetBufferPtr(const SkImageInfo& info, py::buffer& data, size_t rowBytes,
-                    size_t* size) {
-    auto buffer = data.request();
+                    size_t* size, bool writable = false) {
+    auto buffer = data.request(writable);
     size_t given = (buffer.ndim) ? buffer.shape[0] * buffer.strides[0] : 0;
     if (given < info.computeByteSize(rowBytes))
         throw std::runtime_error("Buffer is smaller than required.");
@@ -80,6 +80,11 @@ py::class_<SkImage, sk_sp<SkImage>, SkRefCnt> image(m, "Image",
     streams supported include BMP, GIF, HEIF, ICO, JPEG, PNG, WBMP, WebP.
     Supported encoding details vary with platform.
 
+    Pixels of raster-backed :py:class:`Image` are exported read-only without
+    copy through ``__array_interface__`` and DLPack as an array of shape
+    (height, width, channels); see :py:class:`Pixmap`. Lazy-decoded and GPU
+    images must be converted with :py:meth:`makeRasterImage` first.
+
     .. rubric:: Classes
 
     .. autosummary::
@@ -115,6 +120,15 @@ py::enum_<SkImage::LegacyBitmapMode>(image, "LegacyBitmapMode")
         )docstring")
     .export_values();
 
+DefinePixelExport(image,
+    [] (SkImage& self) {
+        SkPixmap pixmap;
+        if (!self.peekPixels(&pixmap))
+            throw std::runtime_error(
+                "Image is not raster-backed; use makeRasterImage().");
+        return pixmap;
+    }, true);
+
 image
     .def(py::init([] (NumPy<uint8_t> array) {
         py::buffer_info info = array.request();
@@ -371,6 +385,40 @@ image
         py::arg("dstInfo"), py::arg("dstPixels"), py::arg("dstRowBytes"),
         py::arg("srcX") = 0, py::arg("srcY") = 0,
         py::arg("cachingHint") = SkImage::kAllow_CachingHint)
+    .def("readPixelsAsync",
+        [] (SkImage& image, const SkImageInfo& info, py::buffer dst,
+            size_t dstRowBytes, int srcX, int srcY) {
+            if (dstRowBytes == 0)
+                dstRowBytes = info.minRowBytes();
+            auto ptr = GetBufferPtr(info, dst, dstRowBytes, nullptr, true);
+            auto pixels = DataFromBuffer(dst);
+            auto source = sk_ref_sp(&image);
+            return RunAsync([source, info, ptr, pixels, dstRowBytes,
+                             srcX, srcY] () {
+                return source->readPixels(info, ptr, dstRowBytes, srcX, srcY);
+            });
+        },
+        R"docstring(
+        Copies :py:class:`Rect` of pixels from :py:class:`Image` to dstPixels
+        on a background thread.
+
+        Returns an awaitable :py:class:`asyncio.Future` that resolves to the
+        result of :py:meth:`readPixels`. dstPixels stays referenced until the
+        future resolves, and must not be read or resized before then.
+
+        :param skia.ImageInfo dstInfo: destination width, height,
+            :py:class:`ColorType`, :py:class:`AlphaType`,
+            :py:class:`ColorSpace`
+        :param dstPixels: destination pixel storage
+        :param int dstRowBytes: destination row length; may be zero
+        :param int srcX: column index whose absolute value is less than
+            :py:meth:`width`
+        :param int srcY: row index whose absolute value is less than
+            :py:meth:`height`
+        :return: :py:class:`asyncio.Future` of bool
+        )docstring",
+        py::arg("dstInfo"), py::arg("dstPixels"), py::arg("dstRowBytes") = 0,
+        py::arg("srcX") = 0, py::arg("srcY") = 0)
     .def("readPixels",
         py::overload_cast<const SkPixmap&, int, int, SkImage::CachingHint>(
             &SkImage::readPixels, py::const_),
@@ -512,6 +560,34 @@ image
 
         :return: encoded :py:class:`Image`, or nullptr
         )docstring")
+    .def("encodeToDataAsync",
+        [] (SkImage& image, SkEncodedImageFormat format, int quality) {
+            auto source = sk_ref_sp(&image);
+            return RunAsync([source, format, quality] () {
+                auto data = source->encodeToData(format, quality);
+                if (!data)
+                    throw std::runtime_error("Failed to encode");
+                return data;
+            });
+        },
+        R"docstring(
+        Encodes :py:class:`Image` pixels on a background thread.
+
+        Returns an awaitable :py:class:`asyncio.Future` that resolves to the
+        encoded :py:class:`Data`, or fails with :py:class:`RuntimeError` if
+        encoding fails::
+
+            data = await image.encodeToDataAsync()
+
+        :param skia.EncodedImageFormat encodedImageFormat:
+            one of: :py:attr:`~EncodedImageFormat.kJPEG`,
+            :py:attr:`~EncodedImageFormat.kPNG`,
+            :py:attr:`~EncodedImageFormat.kWEBP`
+        :param int quality: encoder specific metric with 100 equaling best
+        :return: :py:class:`asyncio.Future` of :py:class:`Data`
+        )docstring",
+        py::arg("encodedImageFormat") = SkEncodedImageFormat::kPNG,
+        py::arg("quality") = 100)
     .def("refEncodedData", &SkImage::refEncodedData,
         R"docstring(
         Returns encoded :py:class:`Image` pixels as :py:class:`Data`, if
@@ -638,6 +714,42 @@ image
         py::arg("context"), py::arg("filter"), py::arg("subset"),
         py::arg("clipBounds"), py::arg("outSubset").none(false),
         py::arg("offset").none(false))
+    .def("makeWithFilterAsync",
+        [] (SkImage& image, const SkImageFilter& filter,
+            const SkIRect* subset, const SkIRect* clipBounds) {
+            auto source = sk_ref_sp(&image);
+            auto imageFilter = sk_ref_sp(&filter);
+            auto sourceSubset = (subset) ? *subset : source->bounds();
+            auto sourceClip = (clipBounds) ? *clipBounds : source->bounds();
+            return RunAsync([source, imageFilter, sourceSubset, sourceClip] () {
+                SkIRect outSubset;
+                SkIPoint offset;
+                auto filtered = source->makeWithFilter(
+                    nullptr, imageFilter.get(), sourceSubset, sourceClip,
+                    &outSubset, &offset);
+                if (!filtered)
+                    throw std::runtime_error("Failed to filter");
+                return std::make_tuple(filtered, outSubset, offset);
+            });
+        },
+        R"docstring(
+        Creates filtered raster :py:class:`Image` on a background thread.
+
+        Returns an awaitable :py:class:`asyncio.Future` that resolves to a
+        tuple of filtered :py:class:`Image`, its valid bounds as
+        :py:class:`IRect`, and its translation as :py:class:`IPoint`. See
+        :py:meth:`makeWithFilter`.
+
+        :param skia.ImageFilter filter: how :py:class:`Image` is sampled when
+            transformed
+        :param skia.IRect subset: bounds of :py:class:`Image` processed by
+            filter; defaults to :py:meth:`bounds`
+        :param skia.IRect clipBounds: expected bounds of filtered
+            :py:class:`Image`; defaults to :py:meth:`bounds`
+        :return: :py:class:`asyncio.Future` of (image, outSubset, offset)
+        )docstring",
+        py::arg("filter"), py::arg("subset") = nullptr,
+        py::arg("clipBounds") = nullptr)
     .def("asLegacyBitmap", &SkImage::asLegacyBitmap,
         R"docstring(
         Deprecated.
@@ -778,6 +890,43 @@ image
         :return: :py:class:`Image` sharing pixmap
         )docstring",
         py::arg("pixmap").none(false))
+    .def_static("MakeFromShared",
+        [] (py::object shared, const SkImageInfo& info, size_t rowBytes) {
+            rowBytes = (rowBytes == 0) ? info.minRowBytes() : rowBytes;
+            auto context = OpenSharedBuffer(
+                shared, info.computeByteSize(rowBytes), false);
+            auto image = SkImage::MakeFromRaster(
+                SkPixmap(info, context->info.ptr, rowBytes),
+                [] (const void*, void* context) {
+                    ReleaseSharedBuffer(context);
+                }, context);
+            if (!image) {
+                delete context;
+                throw std::runtime_error("Failed to create Image");
+            }
+            return image;
+        },
+        R"docstring(
+        Creates :py:class:`Image` from memory shared between processes, without
+        copy.
+
+        shared is the name of an existing
+        :py:class:`multiprocessing.shared_memory.SharedMemory` block, a
+        :py:class:`~multiprocessing.shared_memory.SharedMemory` object, or any
+        buffer object such as :py:class:`mmap.mmap` over a memfd. The memory
+        stays mapped until :py:class:`Image` is deleted.
+
+        :py:class:`Image` reads the shared pixels directly; the caller must
+        ensure that no process writes to the memory while :py:class:`Image` is
+        in use. See :py:meth:`Surface.MakeRasterShared`.
+
+        :param shared: shared memory name, object, or buffer
+        :param skia.ImageInfo info: contains width, height,
+            :py:class:`AlphaType`, :py:class:`ColorType`, :py:class:`ColorSpace`
+        :param int rowBytes: size of pixel row or larger; may be zero
+        :return: :py:class:`Image` sharing pixels
+        )docstring",
+        py::arg("shared"), py::arg("info"), py::arg("rowBytes") = 0)
     .def_static("MakeFromBitmap", &SkImage::MakeFromBitmap,
         R"docstring(
         Creates :py:class:`Image` from bitmap, sharing or copying bitmap pixels.
@@ -848,6 +997,37 @@ image
         :return: created :py:class:`Image`, or nullptr
         )docstring",
         py::arg("encoded"), py::arg("subset") = nullptr)
+    .def_static("DecodeToRasterAsync",
+        [] (py::buffer data, const SkIRect* subset) {
+            auto buffer = data.request();
+            auto size = (buffer.ndim) ? buffer.shape[0] * buffer.strides[0] : 0;
+            auto encoded = SkData::MakeWithCopy(buffer.ptr, size);
+            bool hasSubset = subset != nullptr;
+            auto bounds = (subset) ? *subset : SkIRect::MakeEmpty();
+            return RunAsync([encoded, hasSubset, bounds] () {
+                auto image = SkImage::DecodeToRaster(
+                    encoded, (hasSubset) ? &bounds : nullptr);
+                if (!image)
+                    throw std::runtime_error("Failed to decode");
+                return image;
+            });
+        },
+        R"docstring(
+        Decodes the data into a raster image on a background thread.
+
+        The data is copied before this returns. Returns an awaitable
+        :py:class:`asyncio.Future` that resolves to the decoded
+        :py:class:`Image`, or fails with :py:class:`RuntimeError` if the
+        encoded format is not supported::
+
+            image = await skia.Image.DecodeToRasterAsync(data)
+
+        :param Union[bytes,bytearray,memoryview] data: the encoded data
+        :param skia.IRect subset:  the bounds of the pixels within the decoded
+            image to return. may be null.
+        :return: :py:class:`asyncio.Future` of :py:class:`Image`
+        )docstring",
+        py::arg("encoded"), py::arg("subset") = nullptr)
     .def_static("DecodeToTexture",
         [] (GrContext* context, py::buffer data, const SkIRect* subset) {
             auto buffer = data.request();
@@ -1124,4 +1304,53 @@ image
         )docstring",
         py::arg("context"), py::arg("image"), py::arg("backendTexture"))
     ;
+
+DefinePickle(image,
+    [] (const SkImage& image, int protocol) {
+        auto encoded = image.refEncodedData();
+        if (encoded)
+            return py::make_tuple(PickleData(encoded, protocol));
+        auto raster = (image.isLazyGenerated() || image.isTextureBacked()) ?
+            image.makeRasterImage() : sk_ref_sp(&image);
+        SkPixmap pixmap;
+        if (!raster || !raster->peekPixels(&pixmap))
+            throw std::runtime_error("Failed to read pixels");
+        // The pickled data refers to the pixels of the raster image.
+        auto pixels = SkData::MakeWithProc(
+            pixmap.addr(), pixmap.computeByteSize(),
+            [] (const void*, void* context) {
+                static_cast<SkImage*>(context)->unref();
+            }, raster.release());
+        auto colorSpace = (pixmap.colorSpace()) ?
+            py::object(PickleData(pixmap.colorSpace()->serialize(), 4)) :
+            py::object(py::none());
+        return py::make_tuple(
+            pixmap.width(), pixmap.height(), pixmap.colorType(),
+            pixmap.alphaType(), colorSpace, pixmap.rowBytes(),
+            PickleData(pixels, protocol));
+    },
+    [] (py::tuple state) {
+        sk_sp<SkImage> image;
+        if (state.size() == 1) {
+            image = SkImage::MakeFromEncoded(
+                DataFromBuffer(state[0].cast<py::buffer>()));
+        } else if (state.size() == 7) {
+            sk_sp<SkColorSpace> colorSpace;
+            if (!state[4].is_none()) {
+                auto info = state[4].cast<py::buffer>().request();
+                colorSpace = SkColorSpace::Deserialize(
+                    info.ptr, info.shape[0] * info.strides[0]);
+            }
+            auto info = SkImageInfo::Make(
+                state[0].cast<int>(), state[1].cast<int>(),
+                state[2].cast<SkColorType>(), state[3].cast<SkAlphaType>(),
+                colorSpace);
+            image = SkImage::MakeRasterData(
+                info, DataFromBuffer(state[6].cast<py::buffer>()),
+                state[5].cast<size_t>());
+        }
+        if (!image)
+            throw py::value_error("Invalid state");
+        return image;
+    });
 }
@@ -187,6 +187,8 @@ imagefilter
         py::arg("data"))
     ;
 
+DefineFlattenablePickle(imagefilter);
+
 py::class_<SkAlphaThresholdFilter>(m, "AlphaThresholdFilter")
     .def_static("Make",
         [] (const SkRegion& region, SkScalar innerMin, SkScalar outerMax,
@@ -34,7 +34,7 @@ py::enum_<SkCoverageMode>(m, "ConvergeMode",
     .value("kLast", SkCoverageMode::kLast)
     .export_values();
 
-py::class_<SkMaskFilter, sk_sp<SkMaskFilter>, SkFlattenable>(
+py::class_<SkMaskFilter, sk_sp<SkMaskFilter>, SkFlattenable> maskfilter(
     m, "MaskFilter",
     R"docstring(
     :py:class:`MaskFilter` is the base class for object that perform
@@ -49,7 +49,9 @@ py::class_<SkMaskFilter, sk_sp<SkMaskFilter>, SkFlattenable>(
 
         ~skia.ShaderMaskFilter
         ~skia.TableMaskFilter
-    )docstring")
+    )docstring");
+
+maskfilter
     .def_static("MakeBlur", &SkMaskFilter::MakeBlur,
         R"docstring(
         Create a blur maskfilter.
@@ -101,6 +103,8 @@ py::class_<SkMaskFilter, sk_sp<SkMaskFilter>, SkFlattenable>(
         py::arg("data"))
     ;
 
+DefineFlattenablePickle(maskfilter);
+
 
 py::class_<SkBlurMaskFilter>(m, "BlurMaskFilter")
     // .def_static("MakeEmboss",
@@ -1768,6 +1768,25 @@ matrix
     .def_readonly_static("kATransY", &SkMatrix::kATransY)
     ;
 
+DefinePickle(matrix,
+    [] (const SkMatrix& matrix, int protocol) {
+        SkScalar buffer[9];
+        matrix.get9(buffer);
+        return py::make_tuple(
+            buffer[0], buffer[1], buffer[2], buffer[3], buffer[4], buffer[5],
+            buffer[6], buffer[7], buffer[8]);
+    },
+    [] (py::tuple state) {
+        if (state.size() != 9)
+            throw py::value_error("Invalid state");
+        SkScalar buffer[9];
+        for (size_t i = 0; i < 9; ++i)
+            buffer[i] = state[i].cast<SkScalar>();
+        SkMatrix matrix;
+        matrix.set9(buffer);
+        return matrix;
+    });
+
 py::implicitly_convertible<NumPy, SkMatrix>();
 
 // M44
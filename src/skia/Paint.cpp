@@ -1,5 +1,6 @@
 #include "common.h"
 #include <pybind11/operators.h>
+#include <pybind11/stl.h>
 
 
 void initColorFilter(py::module &);
@@ -340,6 +341,36 @@ paint
         )docstring",
         py::arg("src"), py::arg("dst"), py::arg("cullRect") = nullptr,
         py::arg("resScale") = 1)
+    .def("getFillPaths",
+        [] (const SkPaint& paint, const std::vector<SkPath>& paths,
+            SkScalar resScale, const SkRect* cullRect) {
+            return MapPaths(paths,
+                [&] (const SkPath& src, SkPath* dst) {
+                    paint.getFillPath(src, dst, cullRect, resScale);
+                });
+        },
+        R"docstring(
+        Returns the filled equivalents of paths, as :py:meth:`getFillPath`
+        returns for each path.
+
+        Paths are processed natively without the GIL, on a thread pool when
+        there are many, to convert whole drawings of strokes to outlines::
+
+            outlines, bounds = paint.getFillPaths(strokes, resScale=4)
+
+        If paint is hairline, results have path effects applied but are not
+        stroked, and are meant to be drawn as hairlines.
+
+        :param List[skia.Path] paths: paths read to create filled versions
+        :param float resScale: if > 1, increase precision, else if
+            (0 < resScale < 1) reduce precision to favor speed and size
+        :param skia.Rect cullRect: optional limit passed to
+            :py:class:`PathEffect`
+        :return: tuple of the list of resulting :py:class:`Path` and an
+            (N, 4) float32 array of their bounds as (left, top, right, bottom)
+        )docstring",
+        py::arg("paths"), py::arg("resScale") = 1,
+        py::arg("cullRect") = nullptr)
     // .def("getFillPath",
     //     py::overload_cast<const SkPath&, SkPath*>(
     //         &SkPaint::getFillPath, py::const_))
@@ -638,6 +669,51 @@ paint
         py::arg("other"))
     ;
 
+DefinePickle(paint,
+    [] (const SkPaint& paint, int protocol) {
+        auto color = paint.getColor4f();
+        return py::make_tuple(
+            py::make_tuple(color.fR, color.fG, color.fB, color.fA),
+            paint.getBlendMode(),
+            paint.getStyle(),
+            paint.getStrokeWidth(),
+            paint.getStrokeMiter(),
+            paint.getStrokeCap(),
+            paint.getStrokeJoin(),
+            paint.isAntiAlias(),
+            paint.isDither(),
+            paint.getFilterQuality(),
+            paint.refShader(),
+            paint.refColorFilter(),
+            paint.refMaskFilter(),
+            paint.refPathEffect(),
+            paint.refImageFilter());
+    },
+    [] (py::tuple state) {
+        if (state.size() != 15)
+            throw py::value_error("Invalid state");
+        auto color = state[0].cast<py::tuple>();
+        SkPaint paint;
+        paint.setColor4f({
+            color[0].cast<float>(), color[1].cast<float>(),
+            color[2].cast<float>(), color[3].cast<float>()}, nullptr);
+        paint.setBlendMode(state[1].cast<SkBlendMode>());
+        paint.setStyle(state[2].cast<SkPaint::Style>());
+        paint.setStrokeWidth(state[3].cast<SkScalar>());
+        paint.setStrokeMiter(state[4].cast<SkScalar>());
+        paint.setStrokeCap(state[5].cast<SkPaint::Cap>());
+        paint.setStrokeJoin(state[6].cast<SkPaint::Join>());
+        paint.setAntiAlias(state[7].cast<bool>());
+        paint.setDither(state[8].cast<bool>());
+        paint.setFilterQuality(state[9].cast<SkFilterQuality>());
+        paint.setShader(state[10].cast<sk_sp<SkShader>>());
+        paint.setColorFilter(state[11].cast<sk_sp<SkColorFilter>>());
+        paint.setMaskFilter(state[12].cast<sk_sp<SkMaskFilter>>());
+        paint.setPathEffect(state[13].cast<sk_sp<SkPathEffect>>());
+        paint.setImageFilter(state[14].cast<sk_sp<SkImageFilter>>());
+        return paint;
+    });
+
 py::class_<SkFlattenable, PyFlattanable, sk_sp<SkFlattenable>, SkRefCnt>
     flattanable(m, "Flattanable", R"docstring(
     :py:class:`Flattenable` is the base class for objects that need to be
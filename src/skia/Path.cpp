@@ -2,6 +2,14 @@
 #include <pybind11/operators.h>
 #include <pybind11/stl.h>
 #include <pybind11/iostream.h>
+#include <pybind11/numpy.h>
+#include <include/core/SkBBHFactory.h>
+#include <include/utils/SkParsePath.h>
+#include <cmath>
+#include <limits>
+
+template<typename T>
+using NumPy = py::array_t<T, py::array::c_style | py::array::forcecast>;
 
 
 template <typename T>
@@ -30,6 +38,143 @@ py::tuple Iter_next(T& it) {
 }
 
 
+namespace {
+
+// Points tested per task of ParallelFor.
+const size_t kPointsPerTask = 4096;
+
+// Returns the (N, 2) float32 view of points, or throws.
+NumPy<float> PointArray(NumPy<float> points) {
+    if (points.ndim() != 2 || points.shape(1) != 2)
+        throw py::value_error("points must have shape (N, 2)");
+    return points;
+}
+
+// Calls fn(begin, end) over chunks of [0, count), in parallel if count is
+// large. Call without the GIL.
+template <typename Fn>
+void ForEachChunk(size_t count, Fn&& fn) {
+    size_t tasks = (count + kPointsPerTask - 1) / kPointsPerTask;
+    if (tasks <= 1) {
+        fn(size_t(0), count);
+        return;
+    }
+    ParallelFor(tasks, [&] (size_t task) {
+        size_t begin = task * kPointsPerTask;
+        fn(begin, std::min(begin + kPointsPerTask, count));
+    });
+}
+
+py::array_t<bool> ContainsPoints(const SkPath& path, NumPy<float> points) {
+    points = PointArray(points);
+    size_t n = points.shape(0);
+    py::array_t<bool> result(n);
+    auto xy = points.data();
+    auto contained = result.mutable_data();
+    // Computes the cached bounds before paths are shared across threads.
+    path.getBounds();
+    {
+        py::gil_scoped_release release;
+        ForEachChunk(n, [&] (size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                contained[i] = path.contains(xy[2 * i], xy[2 * i + 1]);
+        });
+    }
+    return result;
+}
+
+// Immutable list of paths with an R-tree of their bounds, to find the path
+// containing each of many points without testing every path.
+class PathSet {
+public:
+    PathSet(std::vector<SkPath> paths) : fPaths(std::move(paths)) {
+        std::vector<SkRect> bounds(fPaths.size());
+        for (size_t i = 0; i < fPaths.size(); ++i) {
+            bounds[i] = fPaths[i].getBounds();
+            // Inverse fills contain unbounded areas, so they are tested for
+            // every point instead.
+            if (fPaths[i].isInverseFillType()) {
+                fInverse.push_back(SkToInt(i));
+                bounds[i].setEmpty();
+            }
+        }
+        fIndex = SkRTreeFactory()();
+        fIndex->insert(bounds.data(), SkToInt(bounds.size()));
+    }
+
+    const std::vector<SkPath>& paths() const { return fPaths; }
+
+    // Returns the greatest index of a path containing (x, y), or -1.
+    int locate(SkScalar x, SkScalar y, std::vector<int>* candidates) const {
+        const auto inf = std::numeric_limits<SkScalar>::infinity();
+        auto query = SkRect::MakeLTRB(
+            std::nextafter(x, -inf), std::nextafter(y, -inf),
+            std::nextafter(x, inf), std::nextafter(y, inf));
+        candidates->clear();
+        fIndex->search(query, candidates);
+        candidates->insert(
+            candidates->end(), fInverse.begin(), fInverse.end());
+        int found = -1;
+        for (int i : *candidates) {
+            if (i > found && fPaths[i].contains(x, y))
+                found = i;
+        }
+        return found;
+    }
+
+    py::array_t<int32_t> locate(NumPy<float> points) const {
+        points = PointArray(points);
+        size_t n = points.shape(0);
+        py::array_t<int32_t> result(n);
+        auto xy = points.data();
+        auto indices = result.mutable_data();
+        py::gil_scoped_release release;
+        ForEachChunk(n, [&] (size_t begin, size_t end) {
+            std::vector<int> candidates;
+            for (size_t i = begin; i < end; ++i)
+                indices[i] = this->locate(
+                    xy[2 * i], xy[2 * i + 1], &candidates);
+        });
+        return result;
+    }
+
+private:
+    std::vector<SkPath> fPaths;
+    std::vector<int> fInverse;
+    sk_sp<SkBBoxHierarchy> fIndex;
+};
+
+}  // namespace
+
+py::tuple MapPaths(const std::vector<SkPath>& paths,
+                   std::function<void(const SkPath&, SkPath*)> fn) {
+    // Stroking and path effects cost far more per path than a task.
+    const size_t kParallelPaths = 16;
+    size_t n = paths.size();
+    std::vector<SkPath> results(n);
+    NumPy<float> bounds(std::vector<py::ssize_t>{py::ssize_t(n), 4});
+    auto rects = reinterpret_cast<SkRect*>(bounds.mutable_data());
+    for (auto& path : paths)
+        path.getBounds();
+    {
+        py::gil_scoped_release release;
+        auto map = [&] (size_t i) {
+            fn(paths[i], &results[i]);
+            rects[i] = results[i].getBounds();
+        };
+        if (n < kParallelPaths) {
+            for (size_t i = 0; i < n; ++i)
+                map(i);
+        } else {
+            ParallelFor(n, map);
+        }
+    }
+    py::list list(n);
+    for (size_t i = 0; i < n; ++i)
+        list[i] = py::cast(std::move(results[i]));
+    return py::make_tuple(list, bounds);
+}
+
 void initPath(py::module &m) {
 // PathTypes
 py::enum_<SkPathFillType>(m, "PathFillType")
@@ -1764,6 +1909,22 @@ path
         :return: true if :py:class:`Point` is in :py:class:`Path`
         )docstring",
         py::arg("x"), py::arg("y"))
+    .def("containsPoints", &ContainsPoints,
+        R"docstring(
+        Returns whether each point is contained by :py:class:`Path`, taking
+        into account FillType.
+
+        Points are tested in a native loop without the GIL, split across a
+        thread pool when there are many::
+
+            inside = path.containsPoints(np.array([[10, 10], [50, 50]]))
+
+        :param numpy.ndarray points: (N, 2) array of (x, y), converted to
+            float32
+        :return: (N,) bool array
+        :rtype: numpy.ndarray
+        )docstring",
+        py::arg("points"))
     // .def("dump",
     //     py::overload_cast<SkWStream*, bool, bool>(&SkPath::dump),
     //     "Writes text representation of SkPath to stream.")
@@ -1970,6 +2131,172 @@ path
         )docstring",
         py::arg("p0"), py::arg("p1"), py::arg("p2"), py::arg("w"),
         py::arg("pow2"))
+    .def_static("FromSVGString",
+        [] (const std::string& str) {
+            SkPath path;
+            if (!SkParsePath::FromSVGString(str.c_str(), &path))
+                throw py::value_error("Invalid SVG path data");
+            return path;
+        },
+        R"docstring(
+        Parses SVG path data, the ``d`` attribute of ``<path>``, into
+        :py:class:`Path`.
+
+        :param str str: SVG path data, e.g. ``'M0 0 L10 10 Z'``
+        :return: parsed :py:class:`Path`
+        :raise: ValueError if str is not valid path data
+        )docstring",
+        py::arg("str"))
+    .def_static("FromSVGStrings",
+        [] (const std::vector<std::string>& strs) {
+            std::vector<SkPath> paths(strs.size());
+            std::unique_ptr<bool[]> parsed(new bool[strs.size()]);
+            {
+                py::gil_scoped_release release;
+                ParallelFor(strs.size(), [&] (size_t i) {
+                    parsed[i] = SkParsePath::FromSVGString(
+                        strs[i].c_str(), &paths[i]);
+                });
+            }
+            py::list result(strs.size());
+            for (size_t i = 0; i < strs.size(); ++i)
+                result[i] = (parsed[i]) ?
+                    py::cast(std::move(paths[i])) : py::none();
+            return result;
+        },
+        R"docstring(
+        Parses a list of SVG path data strings on a native thread pool, without
+        the GIL.
+
+        :param List[str] strs: SVG path data strings
+        :return: list of parsed :py:class:`Path`, with `None` for strings that
+            are not valid path data
+        :rtype: List[Union[skia.Path,None]]
+        )docstring",
+        py::arg("strs"))
+    .def_static("Op",
+        [] (const SkPath& one, const SkPath& two, SkPathOp op) {
+            SkPath result;
+            if (!Op(one, two, op, &result))
+                throw std::runtime_error("Failed to apply path operation");
+            return result;
+        },
+        R"docstring(
+        Returns the result of applying op to one and two: (one op two).
+
+        The resulting path will be constructed from non-overlapping contours.
+        The curve order is reduced where possible so that cubics may be turned
+        into quadratics, and quadratics maybe turned into lines.
+
+        :param skia.Path one: The first operand (for difference, the minuend)
+        :param skia.Path two: The second operand (for difference, the
+            subtrahend)
+        :param skia.PathOp op: The operator to apply.
+        :return: The product of the operands.
+        :raise: RuntimeError if the operation fails
+        )docstring",
+        py::arg("one"), py::arg("two"), py::arg("op"))
+    .def_static("Op",
+        [] (const std::vector<SkPath>& paths, SkPathOp op) {
+            SkPath result;
+            if (paths.empty())
+                return result;
+            bool resolved;
+            {
+                py::gil_scoped_release release;
+                SkOpBuilder builder;
+                builder.add(paths[0], SkPathOp::kUnion_SkPathOp);
+                for (size_t i = 1; i < paths.size(); ++i)
+                    builder.add(paths[i], op);
+                resolved = builder.resolve(&result);
+            }
+            if (!resolved)
+                throw std::runtime_error("Failed to apply path operation");
+            return result;
+        },
+        R"docstring(
+        Applies op to paths from left to right: ((paths[0] op paths[1]) op
+        paths[2]) ... in a single native pass, without the GIL.
+
+        Merging many polygons is a single call::
+
+            merged = skia.Path.Op(polygons, skia.PathOp.kUnion_PathOp)
+
+        :param List[skia.Path] paths: operands; an empty list gives an empty
+            path
+        :param skia.PathOp op: The operator to apply.
+        :return: The product of the operands.
+        :raise: RuntimeError if the operation fails
+        )docstring",
+        py::arg("paths"), py::arg("op") = SkPathOp::kUnion_SkPathOp)
+    .def_static("Simplify",
+        [] (const SkPath& path) {
+            SkPath result;
+            if (!Simplify(path, &result))
+                throw std::runtime_error("Failed to simplify path");
+            return result;
+        },
+        R"docstring(
+        Returns path with the same filled area as the input, constructed from
+        non-overlapping contours.
+
+        The curve order is reduced where possible so that cubics may be turned
+        into quadratics, and quadratics maybe turned into lines.
+
+        :param skia.Path path: The path to simplify.
+        :return: The simplified path.
+        :raise: RuntimeError if the path cannot be simplified
+        )docstring",
+        py::arg("path"))
+    .def_static("TightBounds",
+        [] (const SkPath& path) {
+            SkRect result;
+            if (!TightBounds(path, &result))
+                throw std::runtime_error("Failed to compute bounds");
+            return result;
+        },
+        R"docstring(
+        Returns the resulting rectangle to the tight bounds of the path.
+
+        :param skia.Path path: The path measured.
+        :return: The tight bounds of the path.
+        :raise: RuntimeError if the bounds cannot be computed
+        )docstring",
+        py::arg("path"))
+    .def_static("AsWinding",
+        [] (const SkPath& path) {
+            SkPath result;
+            if (!AsWinding(path, &result))
+                throw std::runtime_error("Failed to convert path");
+            return result;
+        },
+        R"docstring(
+        Returns path with the same filled area as the input, with
+        :py:attr:`PathFillType.kWinding` fill type.
+
+        The path may be modified to preserve the fill area; contours may be
+        reversed.
+
+        :param skia.Path path: The path typically with fill type set to even
+            odd.
+        :return: The path with fill type set to winding.
+        :raise: RuntimeError if the path cannot be converted
+        )docstring",
+        py::arg("path"))
+    .def("toSVGString",
+        [] (const SkPath& path) {
+            SkString str;
+            SkParsePath::ToSVGString(path, &str);
+            return std::string(str.c_str(), str.size());
+        },
+        R"docstring(
+        Returns SVG path data, suitable for the ``d`` attribute of
+        ``<path>``, with absolute coordinates.
+
+        Fill type is not part of path data.
+
+        :rtype: str
+        )docstring")
     .def(py::self == py::self,
         R"docstring(
         Compares a and b; returns true if :py:class:`Path.FillType`, verb array,
@@ -1989,4 +2316,125 @@ path
         )docstring",
         py::arg("other"))
     ;
+
+py::class_<PathSet>(m, "PathSet", R"docstring(
+    Immutable list of :py:class:`Path` indexed by their bounds, to find the
+    path that contains each of many points, as in hit-testing or assigning
+    points to regions.
+
+    Candidate paths are found in an R-tree of bounds and tested exactly with
+    :py:meth:`Path.contains`, without the GIL and in parallel for large
+    batches::
+
+        regions = skia.PathSet(polygons)
+        indices = regions.locate(np.array([[x0, y0], [x1, y1]]))
+        hit = regions[indices[0]] if indices[0] >= 0 else None
+    )docstring")
+    .def(py::init<std::vector<SkPath>>(),
+        R"docstring(
+        Copies paths and indexes their bounds.
+
+        :param List[skia.Path] paths: paths to search
+        )docstring",
+        py::arg("paths"))
+    .def("locate",
+        py::overload_cast<NumPy<float>>(&PathSet::locate, py::const_),
+        R"docstring(
+        Returns the index of the path containing each point.
+
+        If several paths contain a point, the greatest index, the topmost in
+        drawing order, is returned.
+
+        :param numpy.ndarray points: (N, 2) array of (x, y), converted to
+            float32
+        :return: (N,) int32 array of path indices, with -1 for points that no
+            path contains
+        :rtype: numpy.ndarray
+        )docstring",
+        py::arg("points"))
+    .def("__len__",
+        [] (const PathSet& set) { return set.paths().size(); })
+    .def("__getitem__",
+        [] (const PathSet& set, int index) {
+            int size = SkToInt(set.paths().size());
+            if (index < 0)
+                index += size;
+            if (index < 0 || index >= size)
+                throw py::index_error("Index out of range.");
+            return set.paths()[index];
+        },
+        py::arg("index"))
+    ;
+
+py::class_<SkOpBuilder>(m, "OpBuilder", R"docstring(
+    Perform a series of path operations, optimized for unioning many paths
+    together.
+
+    Paths are accumulated with :py:meth:`add`, and combined in a single
+    native pass by :py:meth:`resolve`::
+
+        builder = skia.OpBuilder()
+        builder.add(paths, skia.PathOp.kUnion_PathOp)
+        merged = builder.resolve()
+    )docstring")
+    .def(py::init<>())
+    .def("add", &SkOpBuilder::add,
+        R"docstring(
+        Add one or more paths and their operand.
+
+        The builder is empty before the first path is added, so the result of
+        a single add is (emptyPath OP path).
+
+        :param skia.Path path: The second operand.
+        :param skia.PathOp operator: The operator to apply to the existing
+            and supplied paths.
+        )docstring",
+        py::arg("path"), py::arg("operator"))
+    .def("add",
+        [] (SkOpBuilder& builder, const std::vector<SkPath>& paths,
+            SkPathOp op) {
+            for (const auto& path : paths)
+                builder.add(path, op);
+        },
+        R"docstring(
+        Add paths with the same operand.
+
+        :param List[skia.Path] paths: The second operands.
+        :param skia.PathOp operator: The operator to apply to the existing
+            and supplied paths.
+        )docstring",
+        py::arg("paths"), py::arg("operator") = SkPathOp::kUnion_SkPathOp)
+    .def("resolve",
+        [] (SkOpBuilder& builder) {
+            SkPath result;
+            bool resolved;
+            {
+                py::gil_scoped_release release;
+                resolved = builder.resolve(&result);
+            }
+            if (!resolved)
+                throw std::runtime_error("Failed to resolve path operations");
+            return result;
+        },
+        R"docstring(
+        Computes the sum of all paths and operands, and resets the builder to
+        its initial state. Releases the GIL while computing.
+
+        :return: The product of the operands.
+        :raise: RuntimeError if the operation fails
+        )docstring")
+    ;
+
+DefinePickle(path,
+    [] (const SkPath& path, int protocol) {
+        return PickleData(path.serialize(), protocol);
+    },
+    [] (py::buffer state) {
+        auto info = state.request();
+        size_t size = (info.ndim) ? info.shape[0] * info.strides[0] : 0;
+        SkPath path;
+        if (!path.readFromMemory(info.ptr, size))
+            throw py::value_error("Invalid data");
+        return path;
+    });
 }
@@ -249,6 +249,38 @@ patheffect
         resulting stroke-rec to dst and then draw.
         )docstring",
         py::arg("dst"), py::arg("dst"), py::arg("stroke_rec"), py::arg("cullR"))
+    .def("filterPaths",
+        [] (const SkPathEffect& effect, const std::vector<SkPath>& paths,
+            const SkStrokeRec& strokeRec, const SkRect* cullRect) {
+            return MapPaths(paths,
+                [&] (const SkPath& src, SkPath* dst) {
+                    SkStrokeRec rec(strokeRec);
+                    if (!effect.filterPath(dst, src, &rec, cullRect))
+                        *dst = src;
+                });
+        },
+        R"docstring(
+        Applies this effect to each of paths.
+
+        Paths are processed natively without the GIL, on a thread pool when
+        there are many. Paths that this effect cannot be applied to are
+        returned unchanged. Changes the effect makes to strokeRec are
+        discarded; use :py:meth:`Paint.getFillPaths` to also stroke the
+        results::
+
+            dashed, bounds = skia.DashPathEffect.Make([10, 5], 0).filterPaths(
+                paths)
+
+        :param List[skia.Path] paths: paths to apply this effect to
+        :param skia.StrokeRec strokeRec: stroke request passed to the effect
+            for each path
+        :param skia.Rect cullRect: optional limit passed to the effect
+        :return: tuple of the list of resulting :py:class:`Path` and an
+            (N, 4) float32 array of their bounds as (left, top, right, bottom)
+        )docstring",
+        py::arg("paths"),
+        py::arg("strokeRec") = SkStrokeRec(SkStrokeRec::kFill_InitStyle),
+        py::arg("cullRect") = nullptr)
     .def("computeFastBounds", &SkPathEffect::computeFastBounds,
         R"docstring(
         Compute a conservative bounds for its effect, given the src bounds.
@@ -303,6 +335,8 @@ patheffect
         py::arg("data"))
     ;
 
+DefineFlattenablePickle(patheffect);
+
 py::class_<SkDiscretePathEffect, SkPathEffect, sk_sp<SkDiscretePathEffect>>(
     m, "DiscretePathEffect")
     .def_static("Make", &SkDiscretePathEffect::Make,
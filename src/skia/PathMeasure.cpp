@@ -0,0 +1,286 @@
+#include "common.h"
+#include <include/core/SkContourMeasure.h>
+#include <include/core/SkPathMeasure.h>
+#include <pybind11/numpy.h>
+
+template<typename T>
+using NumPy = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+namespace {
+
+// Returns (position, tangent) at a scalar distance, or (N, 2) arrays of
+// positions and tangents for an array of distances. Failed samples are None
+// for scalars and NaN for arrays.
+template <typename Measure>
+py::object GetPosTan(Measure& measure, py::object distance) {
+    if (!py::isinstance<py::array>(distance) &&
+        !py::isinstance<py::list>(distance) &&
+        !py::isinstance<py::tuple>(distance)) {
+        SkPoint position;
+        SkVector tangent;
+        if (!measure.getPosTan(distance.cast<SkScalar>(), &position, &tangent))
+            return py::none();
+        return py::make_tuple(position, tangent);
+    }
+    auto distances = distance.cast<NumPy<float>>();
+    auto n = distances.size();
+    NumPy<float> positions(std::vector<py::ssize_t>{n, 2});
+    NumPy<float> tangents(std::vector<py::ssize_t>{n, 2});
+    auto d = distances.data();
+    auto pos = reinterpret_cast<SkPoint*>(positions.mutable_data());
+    auto tan = reinterpret_cast<SkVector*>(tangents.mutable_data());
+    {
+        py::gil_scoped_release release;
+        for (py::ssize_t i = 0; i < n; ++i) {
+            if (!measure.getPosTan(d[i], &pos[i], &tan[i])) {
+                pos[i].set(SK_ScalarNaN, SK_ScalarNaN);
+                tan[i].set(SK_ScalarNaN, SK_ScalarNaN);
+            }
+        }
+    }
+    return py::make_tuple(positions, tangents);
+}
+
+const char* kGetPosTanDoc = R"docstring(
+    Computes the corresponding position and tangent at the specified distance
+    along the contour.
+
+    distance is pinned to 0 <= distance <= length. If distance is a NumPy
+    array or a sequence, all samples are computed in a single native loop
+    without the GIL::
+
+        positions, tangents = measure.getPosTan(
+            np.linspace(0, measure.getLength(), 100))
+
+    :param distance: float, or (N,) array of distances
+    :return: tuple of :py:class:`Point` position and tangent, or `None` if
+        there is no contour; for arrays, tuple of (N, 2) float32 arrays of
+        positions and tangents, with NaN for failed samples
+    )docstring";
+
+}  // namespace
+
+void initPathMeasure(py::module &m) {
+py::class_<SkContourMeasure, sk_sp<SkContourMeasure>, SkRefCnt>
+    contourmeasure(m, "ContourMeasure", R"docstring(
+    Measures a single contour of a :py:class:`Path`; returned by
+    :py:class:`ContourMeasureIter`.
+    )docstring");
+
+py::enum_<SkContourMeasure::MatrixFlags>(
+    contourmeasure, "MatrixFlags", py::arithmetic())
+    .value("kGetPosition_MatrixFlag",
+        SkContourMeasure::MatrixFlags::kGetPosition_MatrixFlag)
+    .value("kGetTangent_MatrixFlag",
+        SkContourMeasure::MatrixFlags::kGetTangent_MatrixFlag)
+    .value("kGetPosAndTan_MatrixFlag",
+        SkContourMeasure::MatrixFlags::kGetPosAndTan_MatrixFlag)
+    .export_values();
+
+contourmeasure
+    .def("length", &SkContourMeasure::length,
+        R"docstring(
+        Return the length of the contour.
+        )docstring")
+    .def("getPosTan", &GetPosTan<SkContourMeasure>, kGetPosTanDoc,
+        py::arg("distance"))
+    .def("getMatrix",
+        [] (const SkContourMeasure& measure, SkScalar distance,
+            SkContourMeasure::MatrixFlags flags) -> py::object {
+            SkMatrix matrix;
+            if (!measure.getMatrix(distance, &matrix, flags))
+                return py::none();
+            return py::cast(matrix);
+        },
+        R"docstring(
+        Computes a :py:class:`Matrix` representing the position and tangent at
+        the specified distance along the contour.
+
+        :param float distance: distance along the contour; pinned to
+            0 <= distance <= length
+        :param skia.ContourMeasure.MatrixFlags flags: which parts of the
+            matrix to compute
+        :return: :py:class:`Matrix`, or `None` if there is no contour
+        )docstring",
+        py::arg("distance"),
+        py::arg("flags") = SkContourMeasure::kGetPosAndTan_MatrixFlag)
+    .def("getSegment",
+        [] (const SkContourMeasure& measure, SkScalar startD, SkScalar stopD,
+            bool startWithMoveTo) -> py::object {
+            SkPath path;
+            if (!measure.getSegment(startD, stopD, &path, startWithMoveTo))
+                return py::none();
+            return py::cast(path);
+        },
+        R"docstring(
+        Returns the intervening segment(s) between startD and stopD.
+
+        If the segment is zero-length, return `None`.
+
+        :param float startD: start distance
+        :param float stopD: stop distance
+        :param bool startWithMoveTo: begin the segment with a moveTo
+        :return: :py:class:`Path` of the segment, or `None`
+        )docstring",
+        py::arg("startD"), py::arg("stopD"), py::arg("startWithMoveTo") = true)
+    .def("isClosed", &SkContourMeasure::isClosed,
+        R"docstring(
+        Return true if the contour is closed.
+        )docstring")
+    ;
+
+py::class_<SkContourMeasureIter>(m, "ContourMeasureIter", R"docstring(
+    Iterates over the contours of a :py:class:`Path`, returning
+    :py:class:`ContourMeasure` for each contour with a non-zero length::
+
+        for contour in skia.ContourMeasureIter(path):
+            print(contour.length())
+    )docstring")
+    .def(py::init<const SkPath&, bool, SkScalar>(),
+        R"docstring(
+        Initialize the iterator with a path.
+
+        The parts of the path that are needed are copied, so the client is
+        free to modify/delete the path after this call.
+
+        resScale controls the precision of the measure. values > 1 increase
+        the precision (and possibly slow down the computation).
+
+        :param skia.Path path: path to measure
+        :param bool forceClosed: treat each contour as closed
+        :param float resScale: precision of the measure
+        )docstring",
+        py::arg("path"), py::arg("forceClosed") = false,
+        py::arg("resScale") = 1)
+    .def("reset", &SkContourMeasureIter::reset,
+        R"docstring(
+        Reset the iterator with a path.
+
+        :param skia.Path path: path to measure
+        :param bool forceClosed: treat each contour as closed
+        :param float resScale: precision of the measure
+        )docstring",
+        py::arg("path"), py::arg("forceClosed") = false,
+        py::arg("resScale") = 1)
+    .def("next", &SkContourMeasureIter::next,
+        R"docstring(
+        Iterates through contours in path, returning a contour-measure object
+        for each contour in the path. Returns `None` when it is done.
+        )docstring")
+    .def("__iter__",
+        [] (SkContourMeasureIter& it) { return &it; },
+        py::return_value_policy::reference_internal)
+    .def("__next__",
+        [] (SkContourMeasureIter& it) {
+            auto contour = it.next();
+            if (!contour)
+                throw py::stop_iteration();
+            return contour;
+        })
+    ;
+
+py::class_<SkPathMeasure> pathmeasure(m, "PathMeasure", R"docstring(
+    Measures the length of a :py:class:`Path` and samples positions and
+    tangents along it, one contour at a time.
+
+    Example::
+
+        measure = skia.PathMeasure(path)
+        distances = np.linspace(0, measure.getLength(), 100)
+        positions, tangents = measure.getPosTan(distances)
+    )docstring");
+
+py::enum_<SkPathMeasure::MatrixFlags>(
+    pathmeasure, "MatrixFlags", py::arithmetic())
+    .value("kGetPosition_MatrixFlag",
+        SkPathMeasure::MatrixFlags::kGetPosition_MatrixFlag)
+    .value("kGetTangent_MatrixFlag",
+        SkPathMeasure::MatrixFlags::kGetTangent_MatrixFlag)
+    .value("kGetPosAndTan_MatrixFlag",
+        SkPathMeasure::MatrixFlags::kGetPosAndTan_MatrixFlag)
+    .export_values();
+
+pathmeasure
+    .def(py::init<>())
+    .def(py::init<const SkPath&, bool, SkScalar>(),
+        R"docstring(
+        Initialize the pathmeasure with the specified path.
+
+        The parts of the path that are needed are copied, so the client is
+        free to modify/delete the path after this call.
+
+        resScale controls the precision of the measure. values > 1 increase
+        the precision (and possibly slow down the computation).
+
+        :param skia.Path path: path to measure
+        :param bool forceClosed: treat each contour as closed
+        :param float resScale: precision of the measure
+        )docstring",
+        py::arg("path"), py::arg("forceClosed") = false,
+        py::arg("resScale") = 1)
+    .def("setPath", &SkPathMeasure::setPath,
+        R"docstring(
+        Reset the pathmeasure with the specified path.
+
+        :param skia.Path path: path to measure; may be `None`
+        :param bool forceClosed: treat each contour as closed
+        )docstring",
+        py::arg("path"), py::arg("forceClosed") = false)
+    .def("getLength", &SkPathMeasure::getLength,
+        R"docstring(
+        Return the total length of the current contour, or 0 if no path is
+        associated.
+        )docstring")
+    .def("getPosTan", &GetPosTan<SkPathMeasure>, kGetPosTanDoc,
+        py::arg("distance"))
+    .def("getMatrix",
+        [] (SkPathMeasure& measure, SkScalar distance,
+            SkPathMeasure::MatrixFlags flags) -> py::object {
+            SkMatrix matrix;
+            if (!measure.getMatrix(distance, &matrix, flags))
+                return py::none();
+            return py::cast(matrix);
+        },
+        R"docstring(
+        Computes a :py:class:`Matrix` representing the position and tangent at
+        the specified distance along the current contour.
+
+        :param float distance: distance along the contour; pinned to
+            0 <= distance <= length
+        :param skia.PathMeasure.MatrixFlags flags: which parts of the matrix
+            to compute
+        :return: :py:class:`Matrix`, or `None` if there is no path
+        )docstring",
+        py::arg("distance"),
+        py::arg("flags") = SkPathMeasure::kGetPosAndTan_MatrixFlag)
+    .def("getSegment",
+        [] (SkPathMeasure& measure, SkScalar startD, SkScalar stopD,
+            bool startWithMoveTo) -> py::object {
+            SkPath path;
+            if (!measure.getSegment(startD, stopD, &path, startWithMoveTo))
+                return py::none();
+            return py::cast(path);
+        },
+        R"docstring(
+        Returns the intervening segment(s) of the current contour between
+        startD and stopD.
+
+        If the segment is zero-length, return `None`.
+
+        :param float startD: start distance
+        :param float stopD: stop distance
+        :param bool startWithMoveTo: begin the segment with a moveTo
+        :return: :py:class:`Path` of the segment, or `None`
+        )docstring",
+        py::arg("startD"), py::arg("stopD"), py::arg("startWithMoveTo") = true)
+    .def("isClosed", &SkPathMeasure::isClosed,
+        R"docstring(
+        Return true if the current contour is closed.
+        )docstring")
+    .def("nextContour", &SkPathMeasure::nextContour,
+        R"docstring(
+        Move to the next contour in the path. Return true if one exists, or
+        false if we're done with the path.
+        )docstring")
+    ;
+}
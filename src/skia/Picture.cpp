@@ -1,4 +1,8 @@
 #include "common.h"
+#include <include/utils/SkNWayCanvas.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
 
 class PyPicture : public SkPicture {
 public:
@@ -32,8 +36,282 @@ public:
     }
 };
 
+// Canvas that forwards draw calls to a target canvas and records the op type,
+// wall-clock duration, and device-space bounds of every draw call.
+class ProfileCanvas : public SkNWayCanvas {
+public:
+    struct Record {
+        const char* name;
+        int64_t nanoseconds;
+        SkRect bounds;
+    };
+
+    ProfileCanvas(SkCanvas* target) : SkNWayCanvas(
+        target->getBaseLayerSize().width(),
+        target->getBaseLayerSize().height()) {
+        // Match the target state before forwarding, so that bounds are in
+        // target device space and the state is not applied to it twice.
+        this->clipRect(SkRect::Make(target->getDeviceClipBounds()));
+        this->setMatrix(target->getTotalMatrix());
+        this->addCanvas(target);
+    }
+
+    const std::vector<Record>& records() const { return fRecords; }
+
+protected:
+    void onDrawPaint(const SkPaint& paint) override {
+        this->profile("drawPaint", SkRect::Make(this->getDeviceClipBounds()),
+            [&] { SkNWayCanvas::onDrawPaint(paint); });
+    }
+    void onDrawRect(const SkRect& rect, const SkPaint& paint) override {
+        this->profile("drawRect", this->deviceBounds(rect, &paint),
+            [&] { SkNWayCanvas::onDrawRect(rect, paint); });
+    }
+    void onDrawRRect(const SkRRect& rrect, const SkPaint& paint) override {
+        this->profile("drawRRect", this->deviceBounds(rrect.rect(), &paint),
+            [&] { SkNWayCanvas::onDrawRRect(rrect, paint); });
+    }
+    void onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
+                      const SkPaint& paint) override {
+        this->profile("drawDRRect", this->deviceBounds(outer.rect(), &paint),
+            [&] { SkNWayCanvas::onDrawDRRect(outer, inner, paint); });
+    }
+    void onDrawOval(const SkRect& rect, const SkPaint& paint) override {
+        this->profile("drawOval", this->deviceBounds(rect, &paint),
+            [&] { SkNWayCanvas::onDrawOval(rect, paint); });
+    }
+    void onDrawArc(const SkRect& rect, SkScalar startAngle,
+                   SkScalar sweepAngle, bool useCenter,
+                   const SkPaint& paint) override {
+        this->profile("drawArc", this->deviceBounds(rect, &paint),
+            [&] {
+                SkNWayCanvas::onDrawArc(
+                    rect, startAngle, sweepAngle, useCenter, paint);
+            });
+    }
+    void onDrawPath(const SkPath& path, const SkPaint& paint) override {
+        this->profile("drawPath",
+            (path.isInverseFillType()) ?
+                SkRect::Make(this->getDeviceClipBounds()) :
+                this->deviceBounds(path.getBounds(), &paint),
+            [&] { SkNWayCanvas::onDrawPath(path, paint); });
+    }
+    void onDrawRegion(const SkRegion& region, const SkPaint& paint) override {
+        this->profile("drawRegion",
+            this->deviceBounds(SkRect::Make(region.getBounds()), &paint),
+            [&] { SkNWayCanvas::onDrawRegion(region, paint); });
+    }
+    void onDrawPoints(PointMode mode, size_t count, const SkPoint pts[],
+                      const SkPaint& paint) override {
+        SkRect bounds;
+        bounds.setBounds(pts, SkToInt(count));
+        this->profile("drawPoints", this->deviceBounds(bounds, &paint),
+            [&] { SkNWayCanvas::onDrawPoints(mode, count, pts, paint); });
+    }
+    void onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                        const SkPaint& paint) override {
+        this->profile("drawTextBlob",
+            this->deviceBounds(blob->bounds().makeOffset(x, y), &paint),
+            [&] { SkNWayCanvas::onDrawTextBlob(blob, x, y, paint); });
+    }
+    void onDrawImage(const SkImage* image, SkScalar left, SkScalar top,
+                     const SkPaint* paint) override {
+        this->profile("drawImage",
+            this->deviceBounds(
+                SkRect::MakeXYWH(left, top, image->width(), image->height()),
+                paint),
+            [&] { SkNWayCanvas::onDrawImage(image, left, top, paint); });
+    }
+    void onDrawImageRect(const SkImage* image, const SkRect* src,
+                         const SkRect& dst, const SkPaint* paint,
+                         SrcRectConstraint constraint) override {
+        this->profile("drawImageRect", this->deviceBounds(dst, paint),
+            [&] {
+                SkNWayCanvas::onDrawImageRect(
+                    image, src, dst, paint, constraint);
+            });
+    }
+    void onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                       const SkPaint* paint) override {
+        SkRect bounds = picture->cullRect();
+        if (matrix)
+            matrix->mapRect(&bounds);
+        this->profile("drawPicture", this->deviceBounds(bounds, paint),
+            [&] { SkNWayCanvas::onDrawPicture(picture, matrix, paint); });
+    }
+    void onDrawBehind(const SkPaint& paint) override {
+        this->profile("drawBehind", SkRect::Make(this->getDeviceClipBounds()),
+            [&] { SkNWayCanvas::onDrawBehind(paint); });
+    }
+    void onDrawVerticesObject(const SkVertices* vertices, SkBlendMode mode,
+                              const SkPaint& paint) override {
+        this->profile("drawVertices",
+            this->deviceBounds(vertices->bounds(), &paint),
+            [&] { SkNWayCanvas::onDrawVerticesObject(vertices, mode, paint); });
+    }
+    void onDrawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                     const SkPoint texCoords[4], SkBlendMode mode,
+                     const SkPaint& paint) override {
+        SkRect bounds;
+        bounds.setBounds(cubics, 12);
+        this->profile("drawPatch", this->deviceBounds(bounds, &paint),
+            [&] {
+                SkNWayCanvas::onDrawPatch(
+                    cubics, colors, texCoords, mode, paint);
+            });
+    }
+    void onDrawImageNine(const SkImage* image, const SkIRect& center,
+                         const SkRect& dst, const SkPaint* paint) override {
+        this->profile("drawImageNine", this->deviceBounds(dst, paint),
+            [&] { SkNWayCanvas::onDrawImageNine(image, center, dst, paint); });
+    }
+    void onDrawImageLattice(const SkImage* image, const Lattice& lattice,
+                            const SkRect& dst, const SkPaint* paint) override {
+        this->profile("drawImageLattice", this->deviceBounds(dst, paint),
+            [&] {
+                SkNWayCanvas::onDrawImageLattice(image, lattice, dst, paint);
+            });
+    }
+    void onDrawAtlas(const SkImage* atlas, const SkRSXform xform[],
+                     const SkRect tex[], const SkColor colors[], int count,
+                     SkBlendMode mode, const SkRect* cull,
+                     const SkPaint* paint) override {
+        this->profile("drawAtlas",
+            (cull) ? this->deviceBounds(*cull, paint) :
+                SkRect::Make(this->getDeviceClipBounds()),
+            [&] {
+                SkNWayCanvas::onDrawAtlas(
+                    atlas, xform, tex, colors, count, mode, cull, paint);
+            });
+    }
+    void onDrawShadowRec(const SkPath& path,
+                         const SkDrawShadowRec& rec) override {
+        this->profile("drawShadowRec",
+            SkRect::Make(this->getDeviceClipBounds()),
+            [&] { SkNWayCanvas::onDrawShadowRec(path, rec); });
+    }
+    void onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
+                          QuadAAFlags aa, const SkColor4f& color,
+                          SkBlendMode mode) override {
+        this->profile("drawEdgeAAQuad", this->deviceBounds(rect, nullptr),
+            [&] {
+                SkNWayCanvas::onDrawEdgeAAQuad(rect, clip, aa, color, mode);
+            });
+    }
+    void onDrawEdgeAAImageSet(const ImageSetEntry set[], int count,
+                              const SkPoint dstClips[],
+                              const SkMatrix preViewMatrices[],
+                              const SkPaint* paint,
+                              SrcRectConstraint constraint) override {
+        auto bounds = SkRect::MakeEmpty();
+        for (int i = 0; i < count; ++i) {
+            auto dst = set[i].fDstRect;
+            if (set[i].fMatrixIndex >= 0)
+                preViewMatrices[set[i].fMatrixIndex].mapRect(&dst);
+            bounds.join(dst);
+        }
+        this->profile("drawEdgeAAImageSet", this->deviceBounds(bounds, paint),
+            [&] {
+                SkNWayCanvas::onDrawEdgeAAImageSet(
+                    set, count, dstClips, preViewMatrices, paint, constraint);
+            });
+    }
+    void onDrawDrawable(SkDrawable* drawable,
+                        const SkMatrix* matrix) override {
+        SkRect bounds = drawable->getBounds();
+        if (matrix)
+            matrix->mapRect(&bounds);
+        this->profile("drawDrawable", this->deviceBounds(bounds, nullptr),
+            [&] { SkNWayCanvas::onDrawDrawable(drawable, matrix); });
+    }
+
+private:
+    SkRect deviceBounds(const SkRect& rect, const SkPaint* paint) const {
+        SkRect storage;
+        const SkRect& bounds = (paint && paint->canComputeFastBounds()) ?
+            paint->computeFastBounds(rect, &storage) : rect;
+        return this->getTotalMatrix().mapRect(bounds);
+    }
+
+    template <typename Fn>
+    void profile(const char* name, const SkRect& bounds, Fn&& draw) {
+        auto start = std::chrono::steady_clock::now();
+        draw();
+        auto end = std::chrono::steady_clock::now();
+        fRecords.push_back({
+            name,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                end - start).count(),
+            bounds});
+    }
+
+    std::vector<Record> fRecords;
+};
+
+py::dict ProfilePicture(const SkPicture& picture, SkCanvas* canvas, int topN) {
+    ProfileCanvas profiler(canvas);
+    picture.playback(&profiler);
+    auto& records = profiler.records();
+
+    struct Stats {
+        int count = 0;
+        int64_t total = 0;
+        int64_t max = 0;
+        SkRect bounds = SkRect::MakeEmpty();
+    };
+    std::map<std::string, Stats> table;
+    for (auto& record : records) {
+        auto& stats = table[record.name];
+        stats.count++;
+        stats.total += record.nanoseconds;
+        stats.max = std::max(stats.max, record.nanoseconds);
+        stats.bounds.join(record.bounds);
+    }
+    std::vector<std::pair<std::string, Stats>> sorted(
+        table.begin(), table.end());
+    std::sort(sorted.begin(), sorted.end(),
+        [] (const std::pair<std::string, Stats>& a,
+            const std::pair<std::string, Stats>& b) {
+            return a.second.total > b.second.total;
+        });
+    py::list ops;
+    for (auto& item : sorted) {
+        py::dict op;
+        op["op"] = item.first;
+        op["count"] = item.second.count;
+        op["total_ns"] = item.second.total;
+        op["max_ns"] = item.second.max;
+        op["bounds"] = item.second.bounds;
+        ops.append(op);
+    }
+
+    std::vector<size_t> indices(records.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+        indices[i] = i;
+    size_t n = std::min(indices.size(), size_t(std::max(topN, 0)));
+    std::partial_sort(indices.begin(), indices.begin() + n, indices.end(),
+        [&] (size_t a, size_t b) {
+            return records[a].nanoseconds > records[b].nanoseconds;
+        });
+    py::list top;
+    for (size_t i = 0; i < n; ++i) {
+        auto& record = records[indices[i]];
+        py::dict op;
+        op["index"] = indices[i];
+        op["op"] = record.name;
+        op["ns"] = record.nanoseconds;
+        op["bounds"] = record.bounds;
+        top.append(op);
+    }
+
+    py::dict result;
+    result["ops"] = ops;
+    result["top"] = top;
+    return result;
+}
+
 void initPicture(py::module &m) {
-py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
+py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt> picture(
     m, "Picture", R"docstring(
     :py:class:`Picture` records drawing commands made to :py:class:`Canvas`.
 
@@ -57,7 +335,9 @@ py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
         canvas.clear(0xFFFFFFFF)
         canvas.drawLine(0, 0, 100, 100, skia.Paint())
         picture = recorder.finishRecordingAsPicture()
-    )docstring")
+    )docstring");
+
+picture
     .def(py::init(&SkPicture::MakePlaceholder),
         R"docstring(
         Returns a placeholder :py:class:`Picture`.
@@ -74,6 +354,7 @@ py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
         )docstring",
         py::arg("cull"))
     .def("playback", [] (SkPicture& picture, SkCanvas* canvas) {
+            py::gil_scoped_release release;
             picture.playback(canvas);
         },
         R"docstring(
@@ -89,6 +370,86 @@ py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
         :param callback: allows interruption of playback
         )docstring",
         py::arg("canvas"))
+    .def("playbackRegion",
+        [] (SkPicture& picture, SkCanvas* canvas, const SkRegion& region) {
+            if (region.isEmpty())
+                return;
+            py::gil_scoped_release release;
+            SkAutoCanvasRestore restore(canvas, true);
+            canvas->clipRegion(region);
+            picture.playback(canvas);
+        },
+        R"docstring(
+        Replays the drawing commands on the specified canvas, clipped to a
+        device-space region.
+
+        Combined with :py:meth:`Surface.takeDamage`, re-renders a scene only
+        where it changed::
+
+            picture.playbackRegion(canvas, surface.takeDamage())
+
+        Commands that fall outside region are rejected by the canvas without
+        rasterizing. Does nothing if region is empty.
+
+        :param skia.Canvas canvas: receiver of drawing commands
+        :param skia.Region region: device-space pixels to redraw
+        )docstring",
+        py::arg("canvas"), py::arg("region"))
+    .def("playbackAsync",
+        [] (SkPicture& picture, SkSurface& surface) {
+            auto source = sk_ref_sp(&picture);
+            auto target = sk_ref_sp(&surface);
+            return RunAsync([source, target] () {
+                source->playback(target->getCanvas());
+                return target;
+            });
+        },
+        R"docstring(
+        Replays the drawing commands on the canvas of surface on a background
+        thread.
+
+        Returns an awaitable :py:class:`asyncio.Future` that resolves to
+        surface once playback finishes. surface must not be used until then::
+
+            surface = await picture.playbackAsync(skia.Surface(640, 480))
+            image = surface.makeImageSnapshot()
+
+        :param skia.Surface surface: raster surface to draw to
+        :return: :py:class:`asyncio.Future` of :py:class:`Surface`
+        )docstring",
+        py::arg("surface"))
+    .def("profile", &ProfilePicture,
+        R"docstring(
+        Replays the drawing commands on the specified canvas and measures the
+        time spent in each draw command.
+
+        Each draw command is forwarded to canvas as in :py:meth:`playback`,
+        and its op type, wall-clock duration in nanoseconds, and device-space
+        bounds are recorded. Matrix, clip, and annotation commands are
+        forwarded but not timed. Draws whose bounds are unknown, such as
+        ``drawBehind`` and ``drawShadowRec``, report the device clip bounds.
+        For GPU-backed canvas, the time reflects only the CPU-side cost of
+        recording the command.
+
+        Example::
+
+            stats = picture.profile(canvas, topN=5)
+            for op in stats['ops']:
+                print(op['op'], op['count'], op['total_ns'], op['max_ns'])
+            for op in stats['top']:
+                print(op['index'], op['op'], op['ns'], op['bounds'])
+
+        :param skia.Canvas canvas: receiver of drawing commands
+        :param int topN: number of the most expensive individual draw commands
+            to report
+        :return: dict with ``ops``, a list of per-op-type statistics (``op``,
+            ``count``, ``total_ns``, ``max_ns``, and ``bounds``) sorted by
+            total time, and ``top``, a list of the topN most expensive draw
+            commands (``index``, ``op``, ``ns``, and ``bounds``) where index is
+            the position of the draw command in playback order
+        :rtype: dict
+        )docstring",
+        py::arg("canvas").none(false), py::arg("topN") = 10)
     .def("cullRect", &SkPicture::cullRect,
         R"docstring(
         Returns cull :py:class:`Rect` for this picture, passed in when
@@ -196,6 +557,17 @@ py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
         py::arg("cull"))
     ;
 
+DefinePickle(picture,
+    [] (const SkPicture& picture, int protocol) {
+        return PickleData(picture.serialize(), protocol);
+    },
+    [] (py::buffer state) {
+        auto picture = SkPicture::MakeFromData(DataFromBuffer(state).get());
+        if (!picture)
+            throw py::value_error("Invalid data");
+        return picture;
+    });
+
 py::class_<SkDrawable, sk_sp<SkDrawable>, SkFlattenable>(m, "Drawable",
     R"docstring(
     Base-class for objects that draw into :py:class:`Canvas`.
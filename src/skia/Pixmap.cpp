@@ -10,7 +10,7 @@ py::memoryview AddrN(const SkPixmap& pixmap) {
             sizeof(T),
             py::format_descriptor<T>::format(),
             2,
-            { pixmap.rowBytesAsPixels(), pixmap.height() },
+            { pixmap.height(), pixmap.rowBytesAsPixels() },
             { pixmap.rowBytes(), sizeof(T) },
             readonly
         )
@@ -32,15 +32,232 @@ py::memoryview Addr(const SkPixmap& pixmap) {
             bytesPerPixel,
             format,
             2,
-            { pixmap.rowBytesAsPixels(), pixmap.height() },
+            { pixmap.height(), pixmap.rowBytesAsPixels() },
             { ssize_t(pixmap.rowBytes()), bytesPerPixel },
             readonly
         )
     );
 }
 
+namespace {
+
+// DLPack ABI, as defined by dlpack.h.
+struct DLDevice {
+    int32_t device_type;
+    int32_t device_id;
+};
+
+struct DLDataType {
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+};
+
+struct DLTensor {
+    void* data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t* shape;
+    int64_t* strides;
+    uint64_t byte_offset;
+};
+
+struct DLManagedTensor {
+    DLTensor dl_tensor;
+    void* manager_ctx;
+    void (*deleter)(DLManagedTensor* self);
+};
+
+struct DLPackVersion {
+    uint32_t major;
+    uint32_t minor;
+};
+
+struct DLManagedTensorVersioned {
+    DLPackVersion version;
+    void* manager_ctx;
+    void (*deleter)(DLManagedTensorVersioned* self);
+    uint64_t flags;
+    DLTensor dl_tensor;
+};
+
+#ifdef SK_CPU_BENDIAN
+const char* kByteOrder = ">";
+#else
+const char* kByteOrder = "<";
+#endif
+
+const int32_t kDLCPU = 1;
+const uint8_t kDLUInt = 1;
+const uint8_t kDLFloat = 2;
+const uint64_t kDLReadOnlyFlag = 1 << 0;
+const uint64_t kDLIsCopiedFlag = 1 << 1;
+
+// Element type of (H, W, C) pixel arrays. Packed formats such as
+// kRGB_565_ColorType have one unsigned integer channel per pixel.
+struct PixelElement {
+    uint8_t code;
+    int size;
+    int channels;
+};
+
+PixelElement GetPixelElement(const SkImageInfo& info) {
+    switch (info.colorType()) {
+        case kUnknown_SkColorType:
+            throw std::runtime_error("Pixels have unknown color type.");
+        case kAlpha_8_SkColorType:
+        case kGray_8_SkColorType:
+            return { kDLUInt, 1, 1 };
+        case kR8G8_unorm_SkColorType:
+            return { kDLUInt, 1, 2 };
+        case kRGBA_8888_SkColorType:
+        case kRGB_888x_SkColorType:
+        case kBGRA_8888_SkColorType:
+            return { kDLUInt, 1, 4 };
+        case kA16_unorm_SkColorType:
+            return { kDLUInt, 2, 1 };
+        case kR16G16_unorm_SkColorType:
+            return { kDLUInt, 2, 2 };
+        case kR16G16B16A16_unorm_SkColorType:
+            return { kDLUInt, 2, 4 };
+        case kA16_float_SkColorType:
+            return { kDLFloat, 2, 1 };
+        case kR16G16_float_SkColorType:
+            return { kDLFloat, 2, 2 };
+        case kRGBA_F16Norm_SkColorType:
+        case kRGBA_F16_SkColorType:
+            return { kDLFloat, 2, 4 };
+        case kRGBA_F32_SkColorType:
+            return { kDLFloat, 4, 4 };
+        default:
+            return { kDLUInt, info.bytesPerPixel(), 1 };
+    }
+}
+
+// Owns the exported tensor, and either keeps the pixel owner alive or holds a
+// copy of the pixels.
+struct DLPackContext {
+    py::object owner;
+    sk_sp<SkData> copy;
+    int64_t shape[3];
+    int64_t strides[3];
+    DLManagedTensor tensor;
+    DLManagedTensorVersioned versioned;
+};
+
+void DeleteDLPackContext(DLManagedTensor* tensor) {
+    py::gil_scoped_acquire acquire;
+    delete static_cast<DLPackContext*>(tensor->manager_ctx);
+}
+
+void DeleteDLPackContextVersioned(DLManagedTensorVersioned* tensor) {
+    py::gil_scoped_acquire acquire;
+    delete static_cast<DLPackContext*>(tensor->manager_ctx);
+}
+
+// A consumer renames the capsule to "used_dltensor" or
+// "used_dltensor_versioned" and takes ownership.
+void DeleteDLPackCapsule(PyObject* capsule) {
+    if (!PyCapsule_IsValid(capsule, "dltensor"))
+        return;
+    auto tensor = static_cast<DLManagedTensor*>(
+        PyCapsule_GetPointer(capsule, "dltensor"));
+    tensor->deleter(tensor);
+}
+
+void DeleteDLPackCapsuleVersioned(PyObject* capsule) {
+    if (!PyCapsule_IsValid(capsule, "dltensor_versioned"))
+        return;
+    auto tensor = static_cast<DLManagedTensorVersioned*>(
+        PyCapsule_GetPointer(capsule, "dltensor_versioned"));
+    tensor->deleter(tensor);
+}
+
+}  // namespace
+
+py::dict PixmapArrayInterface(const SkPixmap& pixmap, bool readonly) {
+    auto element = GetPixelElement(pixmap.info());
+    py::dict interface;
+    interface["shape"] = py::make_tuple(
+        pixmap.height(), pixmap.width(), element.channels);
+    interface["typestr"] = py::str(
+        std::string((element.size == 1) ? "|" : kByteOrder) +
+        ((element.code == kDLFloat) ? "f" : "u") +
+        std::to_string(element.size));
+    interface["strides"] = py::make_tuple(
+        pixmap.rowBytes(), pixmap.info().bytesPerPixel(), element.size);
+    interface["data"] = py::make_tuple(
+        reinterpret_cast<uintptr_t>(pixmap.addr()), readonly);
+    interface["version"] = 3;
+    return interface;
+}
+
+py::object PixmapDLPack(const SkPixmap& pixmap, py::object owner,
+                        bool readonly, py::object maxVersion,
+                        py::object copy, py::object device) {
+    auto element = GetPixelElement(pixmap.info());
+    if (pixmap.rowBytes() % element.size)
+        throw std::runtime_error(
+            "Row bytes must be a multiple of the element size.");
+    if (!device.is_none() &&
+        !device.equal(py::make_tuple(kDLCPU, 0)))
+        throw py::buffer_error("Pixels can only be exported to CPU.");
+    bool versioned = !maxVersion.is_none() &&
+        maxVersion.cast<py::tuple>()[0].cast<int>() >= 1;
+    bool copied = !copy.is_none() && copy.cast<bool>();
+    // Legacy capsules cannot mark tensors read-only.
+    if (readonly && !versioned && !copied)
+        throw py::buffer_error(
+            "Read-only pixels need a DLPack 1.0 consumer, or copy=True.");
+
+    std::unique_ptr<DLPackContext> context(new DLPackContext{
+        owner, nullptr,
+        { pixmap.height(), pixmap.width(), element.channels },
+        { int64_t(pixmap.rowBytes() / element.size), element.channels, 1 },
+        {}, {}});
+    void* data = pixmap.writable_addr();
+    if (copied) {
+        context->copy = SkData::MakeWithCopy(
+            pixmap.addr(), pixmap.computeByteSize());
+        context->owner = py::none();
+        data = context->copy->writable_data();
+    }
+    DLTensor tensor;
+    tensor.data = data;
+    tensor.device = { kDLCPU, 0 };
+    tensor.ndim = 3;
+    tensor.dtype = { element.code, uint8_t(8 * element.size), 1 };
+    tensor.shape = context->shape;
+    tensor.strides = context->strides;
+    tensor.byte_offset = 0;
+
+    PyObject* capsule;
+    if (versioned) {
+        auto& managed = context->versioned;
+        managed.version = { 1, 0 };
+        managed.manager_ctx = context.get();
+        managed.deleter = &DeleteDLPackContextVersioned;
+        managed.flags = (copied) ? kDLIsCopiedFlag :
+            (readonly) ? kDLReadOnlyFlag : 0;
+        managed.dl_tensor = tensor;
+        capsule = PyCapsule_New(
+            &managed, "dltensor_versioned", &DeleteDLPackCapsuleVersioned);
+    } else {
+        auto& managed = context->tensor;
+        managed.dl_tensor = tensor;
+        managed.manager_ctx = context.get();
+        managed.deleter = &DeleteDLPackContext;
+        capsule = PyCapsule_New(&managed, "dltensor", &DeleteDLPackCapsule);
+    }
+    if (!capsule)
+        throw py::error_already_set();
+    context.release();
+    return py::reinterpret_steal<py::object>(capsule);
+}
+
 void initPixmap(py::module &m) {
-py::class_<SkPixmap>(m, "Pixmap", R"docstring(
+py::class_<SkPixmap> pixmap(m, "Pixmap", R"docstring(
     :py:class:`Pixmap` provides a utility to pair :py:class:`ImageInfo` with
     pixels and row bytes.
 
@@ -55,7 +272,26 @@ py::class_<SkPixmap>(m, "Pixmap", R"docstring(
     :py:class:`Pixmap` does not try to manage the lifetime of the pixel memory.
     Use :py:class:`PixelRef` to manage pixel memory; :py:class:`PixelRef` is
     safe across threads.
-    )docstring")
+
+    :py:class:`Pixmap` exports its pixels to NumPy, PyTorch and other array
+    libraries without copy, through ``__array_interface__`` and DLPack. The
+    array has shape (height, width, channels); packed color types such as
+    :py:attr:`~ColorType.kRGB_565_ColorType` have one integer channel::
+
+        array = np.asarray(pixmap)
+        tensor = torch.from_dlpack(pixmap)
+
+    The exported array does not keep the pixel memory alive.
+    )docstring");
+
+DefinePixelExport(pixmap,
+    [] (SkPixmap& self) {
+        if (!self.addr())
+            throw std::runtime_error("Pixmap has no pixels.");
+        return self;
+    }, false);
+
+pixmap
     .def(py::init<>(),
         R"docstring(
         Creates an empty :py:class:`Pixmap` without pixels, with
@@ -172,6 +172,8 @@ shader
         py::arg("data"))
     ;
 
+DefineFlattenablePickle(shader);
+
 py::class_<SkShaders>(m, "Shaders")
     .def_static("Empty", &SkShaders::Empty)
     .def_static("Color", py::overload_cast<SkColor>(&SkShaders::Color),
@@ -0,0 +1,158 @@
+#include "common.h"
+#include <mutex>
+
+// SkWStream that writes to a Python file-like object. Document backends may
+// write from worker threads while the owning thread holds the GIL, so writes
+// from threads without the GIL are queued, never waiting for the GIL, and
+// passed to the file on the next write or flush by a thread that holds it.
+class PyFileWStream : public SkWStream {
+public:
+    PyFileWStream(py::object file) : fFile(file), fBytesWritten(0) {}
+
+    ~PyFileWStream() override {
+        try {
+            this->drain();
+        } catch (py::error_already_set&) {
+            // Nothing to report to from a destructor.
+        }
+    }
+
+    bool write(const void* buffer, size_t size) override {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fPending.write(buffer, size);
+            fBytesWritten += size;
+        }
+        if (PyGILState_Check()) {
+            try {
+                this->drain();
+            } catch (py::error_already_set&) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void flush() override {
+        if (!PyGILState_Check())
+            return;
+        this->drain();
+        if (py::hasattr(fFile, "flush"))
+            fFile.attr("flush")();
+    }
+
+    size_t bytesWritten() const override {
+        std::lock_guard<std::mutex> lock(fMutex);
+        return fBytesWritten;
+    }
+
+private:
+    void drain() {
+        sk_sp<SkData> data;
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            if (fPending.bytesWritten() == 0)
+                return;
+            data = fPending.detachAsData();
+        }
+        fFile.attr("write")(py::bytes(
+            static_cast<const char*>(data->data()), data->size()));
+    }
+
+    py::object fFile;
+    mutable std::mutex fMutex;
+    SkDynamicMemoryWStream fPending;
+    size_t fBytesWritten;
+};
+
+void initStream(py::module &m) {
+py::class_<SkWStream> wstream(m, "WStream", R"docstring(
+    :py:class:`WStream` is a destination of serialized output such as
+    :py:class:`Document` and :py:class:`SVGCanvas`.
+
+    :py:class:`WStream` can be created from a Python file-like object that
+    has a ``write`` method::
+
+        with open('output.pdf', 'wb') as f:
+            stream = skia.WStream(f)
+            ...
+            stream.flush()
+
+    Writes are passed to the file as they happen, so output is streamed
+    without holding the whole document in memory. See also
+    :py:class:`FILEWStream` and :py:class:`DynamicMemoryWStream`.
+    )docstring");
+
+wstream
+    .def(py::init(
+        [] (py::object file) {
+            if (!py::hasattr(file, "write"))
+                throw py::type_error("file must have a write method");
+            return std::unique_ptr<SkWStream>(new PyFileWStream(file));
+        }),
+        R"docstring(
+        Creates :py:class:`WStream` that writes to a Python file-like object.
+
+        :param file: object with ``write`` and optionally ``flush`` methods
+        )docstring",
+        py::arg("file"))
+    .def("write",
+        [] (SkWStream& stream, py::buffer b) {
+            auto info = b.request();
+            size_t size = (info.ndim) ? info.strides[0] * info.shape[0] : 0;
+            return stream.write(info.ptr, size);
+        },
+        R"docstring(
+        Writes bytes to the stream.
+
+        :param Union[bytes,bytearray,memoryview] data: bytes to write
+        :return: true if the write succeeded
+        )docstring",
+        py::arg("data"))
+    .def("flush", &SkWStream::flush,
+        R"docstring(
+        Passes buffered bytes to the destination.
+        )docstring")
+    .def("bytesWritten", &SkWStream::bytesWritten,
+        R"docstring(
+        Returns the number of bytes written to the stream.
+        )docstring")
+    ;
+
+py::class_<SkFILEWStream, SkWStream>(m, "FILEWStream", R"docstring(
+    :py:class:`WStream` that writes to a file path.
+    )docstring")
+    .def(py::init<const char*>(),
+        R"docstring(
+        Opens the file at path for writing.
+
+        :param str path: file path
+        )docstring",
+        py::arg("path"))
+    .def("isValid", &SkFILEWStream::isValid,
+        R"docstring(
+        Returns true if the file was opened.
+        )docstring")
+    .def("fsync", &SkFILEWStream::fsync,
+        R"docstring(
+        Flushes the file and synchronizes it to the storage device.
+        )docstring")
+    ;
+
+py::class_<SkDynamicMemoryWStream, SkWStream>(m, "DynamicMemoryWStream",
+    R"docstring(
+    :py:class:`WStream` that writes to growable memory.
+    )docstring")
+    .def(py::init<>())
+    .def("detachAsData", &SkDynamicMemoryWStream::detachAsData,
+        R"docstring(
+        Returns the written bytes as :py:class:`Data`, and resets the stream.
+
+        :rtype: skia.Data
+        )docstring")
+    .def("reset", &SkDynamicMemoryWStream::reset,
+        R"docstring(
+        Discards the written bytes.
+        )docstring")
+    ;
+}
@@ -1,12 +1,304 @@
 #include "common.h"
+#include <include/utils/SkNWayCanvas.h>
 #include <pybind11/operators.h>
 #include <pybind11/numpy.h>
+#include <unordered_map>
 
 template<typename T>
 using NumPy = py::array_t<T, py::array::c_style | py::array::forcecast>;
 
 const SkSurfaceProps::Flags SkSurfaceProps::kUseDistanceFieldFonts_Flag;
 
+SharedBuffer* OpenSharedBuffer(
+    py::object source, size_t required, bool writable) {
+    py::object owner = source;
+    if (py::isinstance<py::str>(source)) {
+        auto SharedMemory = py::module::import(
+            "multiprocessing.shared_memory").attr("SharedMemory");
+        // Attaching must not register the block with resource_tracker, which
+        // would unlink it when this process exits (bpo-38119).
+#if PY_VERSION_HEX >= 0x030D0000
+        owner = SharedMemory(source, py::arg("track") = false);
+#else
+        owner = SharedMemory(source);
+#ifndef _WIN32
+        py::module::import("multiprocessing.resource_tracker").attr(
+            "unregister")(owner.attr("_name"), "shared_memory");
+#endif
+#endif
+    }
+    py::object buffer = (py::hasattr(owner, "buf")) ?
+        owner.attr("buf") : owner;
+    std::unique_ptr<SharedBuffer> shared(new SharedBuffer{
+        owner, buffer.cast<py::buffer>().request(writable)});
+    auto& info = shared->info;
+    size_t size = (info.ndim > 0) ? info.shape[0] * info.strides[0] : 0;
+    if (size < required)
+        throw std::runtime_error("Shared memory is smaller than required");
+    return shared.release();
+}
+
+void ReleaseSharedBuffer(void* context) {
+    py::gil_scoped_acquire acquire;
+    delete static_cast<SharedBuffer*>(context);
+}
+
+namespace {
+
+// Canvas that forwards draw calls to a surface canvas and accumulates their
+// device-space bounds, clipped and rounded out conservatively, into a region.
+// Draws whose bounds cannot be computed damage the whole clip.
+class DamageCanvas : public SkNWayCanvas {
+public:
+    DamageCanvas(SkCanvas* target) : SkNWayCanvas(
+        target->getBaseLayerSize().width(),
+        target->getBaseLayerSize().height()), fEnabled(true) {
+        // Match the target state before forwarding, so that it is not applied
+        // to the target twice.
+        this->clipRect(SkRect::Make(target->getDeviceClipBounds()));
+        this->setMatrix(target->getTotalMatrix());
+        this->addCanvas(target);
+    }
+
+    bool enabled() const { return fEnabled; }
+    void setEnabled(bool enabled) { fEnabled = enabled; }
+
+    SkRegion takeDamage() {
+        SkRegion damage;
+        damage.swap(fDamage);
+        return damage;
+    }
+
+protected:
+    SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override {
+        // Layers with filters or non-default blending can touch pixels that
+        // none of their draws cover.
+        if (rec.fBackdrop || (rec.fPaint && (
+                rec.fPaint->getImageFilter() ||
+                !rec.fPaint->isSrcOver())))
+            this->damage(rec.fBounds, nullptr);
+        return SkNWayCanvas::getSaveLayerStrategy(rec);
+    }
+    void onDrawPaint(const SkPaint& paint) override {
+        this->damage(nullptr, &paint);
+        SkNWayCanvas::onDrawPaint(paint);
+    }
+    void onDrawBehind(const SkPaint& paint) override {
+        this->damage(nullptr, &paint);
+        SkNWayCanvas::onDrawBehind(paint);
+    }
+    void onDrawRect(const SkRect& rect, const SkPaint& paint) override {
+        this->damage(&rect, &paint);
+        SkNWayCanvas::onDrawRect(rect, paint);
+    }
+    void onDrawRRect(const SkRRect& rrect, const SkPaint& paint) override {
+        this->damage(&rrect.rect(), &paint);
+        SkNWayCanvas::onDrawRRect(rrect, paint);
+    }
+    void onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
+                      const SkPaint& paint) override {
+        this->damage(&outer.rect(), &paint);
+        SkNWayCanvas::onDrawDRRect(outer, inner, paint);
+    }
+    void onDrawOval(const SkRect& rect, const SkPaint& paint) override {
+        this->damage(&rect, &paint);
+        SkNWayCanvas::onDrawOval(rect, paint);
+    }
+    void onDrawArc(const SkRect& rect, SkScalar startAngle,
+                   SkScalar sweepAngle, bool useCenter,
+                   const SkPaint& paint) override {
+        this->damage(&rect, &paint);
+        SkNWayCanvas::onDrawArc(rect, startAngle, sweepAngle, useCenter, paint);
+    }
+    void onDrawPath(const SkPath& path, const SkPaint& paint) override {
+        this->damage(
+            (path.isInverseFillType()) ? nullptr : &path.getBounds(), &paint);
+        SkNWayCanvas::onDrawPath(path, paint);
+    }
+    void onDrawRegion(const SkRegion& region, const SkPaint& paint) override {
+        auto bounds = SkRect::Make(region.getBounds());
+        this->damage(&bounds, &paint);
+        SkNWayCanvas::onDrawRegion(region, paint);
+    }
+    void onDrawPoints(PointMode mode, size_t count, const SkPoint pts[],
+                      const SkPaint& paint) override {
+        SkRect bounds;
+        bounds.setBounds(pts, SkToInt(count));
+        this->damage(&bounds, &paint);
+        SkNWayCanvas::onDrawPoints(mode, count, pts, paint);
+    }
+    void onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                        const SkPaint& paint) override {
+        auto bounds = blob->bounds().makeOffset(x, y);
+        this->damage(&bounds, &paint);
+        SkNWayCanvas::onDrawTextBlob(blob, x, y, paint);
+    }
+    void onDrawVerticesObject(const SkVertices* vertices, SkBlendMode mode,
+                              const SkPaint& paint) override {
+        this->damage(&vertices->bounds(), &paint);
+        SkNWayCanvas::onDrawVerticesObject(vertices, mode, paint);
+    }
+    void onDrawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                     const SkPoint texCoords[4], SkBlendMode mode,
+                     const SkPaint& paint) override {
+        SkRect bounds;
+        bounds.setBounds(cubics, 12);
+        this->damage(&bounds, &paint);
+        SkNWayCanvas::onDrawPatch(cubics, colors, texCoords, mode, paint);
+    }
+    void onDrawImage(const SkImage* image, SkScalar left, SkScalar top,
+                     const SkPaint* paint) override {
+        auto bounds = SkRect::MakeXYWH(
+            left, top, image->width(), image->height());
+        this->damage(&bounds, paint);
+        SkNWayCanvas::onDrawImage(image, left, top, paint);
+    }
+    void onDrawImageRect(const SkImage* image, const SkRect* src,
+                         const SkRect& dst, const SkPaint* paint,
+                         SrcRectConstraint constraint) override {
+        this->damage(&dst, paint);
+        SkNWayCanvas::onDrawImageRect(image, src, dst, paint, constraint);
+    }
+    void onDrawImageNine(const SkImage* image, const SkIRect& center,
+                         const SkRect& dst, const SkPaint* paint) override {
+        this->damage(&dst, paint);
+        SkNWayCanvas::onDrawImageNine(image, center, dst, paint);
+    }
+    void onDrawImageLattice(const SkImage* image, const Lattice& lattice,
+                            const SkRect& dst, const SkPaint* paint) override {
+        this->damage(&dst, paint);
+        SkNWayCanvas::onDrawImageLattice(image, lattice, dst, paint);
+    }
+    void onDrawBitmap(const SkBitmap& bitmap, SkScalar left, SkScalar top,
+                      const SkPaint* paint) override {
+        auto bounds = SkRect::MakeXYWH(
+            left, top, bitmap.width(), bitmap.height());
+        this->damage(&bounds, paint);
+        SkNWayCanvas::onDrawBitmap(bitmap, left, top, paint);
+    }
+    void onDrawBitmapRect(const SkBitmap& bitmap, const SkRect* src,
+                          const SkRect& dst, const SkPaint* paint,
+                          SrcRectConstraint constraint) override {
+        this->damage(&dst, paint);
+        SkNWayCanvas::onDrawBitmapRect(bitmap, src, dst, paint, constraint);
+    }
+    void onDrawBitmapNine(const SkBitmap& bitmap, const SkIRect& center,
+                          const SkRect& dst, const SkPaint* paint) override {
+        this->damage(&dst, paint);
+        SkNWayCanvas::onDrawBitmapNine(bitmap, center, dst, paint);
+    }
+    void onDrawBitmapLattice(const SkBitmap& bitmap, const Lattice& lattice,
+                             const SkRect& dst, const SkPaint* paint) override {
+        this->damage(&dst, paint);
+        SkNWayCanvas::onDrawBitmapLattice(bitmap, lattice, dst, paint);
+    }
+    void onDrawAtlas(const SkImage* atlas, const SkRSXform xform[],
+                     const SkRect tex[], const SkColor colors[], int count,
+                     SkBlendMode mode, const SkRect* cull,
+                     const SkPaint* paint) override {
+        this->damage(cull, paint);
+        SkNWayCanvas::onDrawAtlas(
+            atlas, xform, tex, colors, count, mode, cull, paint);
+    }
+    void onDrawShadowRec(const SkPath& path,
+                         const SkDrawShadowRec& rec) override {
+        this->damage(nullptr, nullptr);
+        SkNWayCanvas::onDrawShadowRec(path, rec);
+    }
+    void onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
+                          QuadAAFlags aa, const SkColor4f& color,
+                          SkBlendMode mode) override {
+        this->damage(&rect, nullptr);
+        SkNWayCanvas::onDrawEdgeAAQuad(rect, clip, aa, color, mode);
+    }
+    void onDrawEdgeAAImageSet(const ImageSetEntry set[], int count,
+                              const SkPoint dstClips[],
+                              const SkMatrix preViewMatrices[],
+                              const SkPaint* paint,
+                              SrcRectConstraint constraint) override {
+        auto bounds = SkRect::MakeEmpty();
+        for (int i = 0; i < count; ++i) {
+            auto dst = set[i].fDstRect;
+            if (set[i].fMatrixIndex >= 0)
+                preViewMatrices[set[i].fMatrixIndex].mapRect(&dst);
+            bounds.join(dst);
+        }
+        this->damage(&bounds, paint);
+        SkNWayCanvas::onDrawEdgeAAImageSet(
+            set, count, dstClips, preViewMatrices, paint, constraint);
+    }
+    void onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                       const SkPaint* paint) override {
+        SkRect bounds = picture->cullRect();
+        if (matrix)
+            matrix->mapRect(&bounds);
+        this->damage(&bounds, paint);
+        SkNWayCanvas::onDrawPicture(picture, matrix, paint);
+    }
+    void onDrawDrawable(SkDrawable* drawable,
+                        const SkMatrix* matrix) override {
+        SkRect bounds = drawable->getBounds();
+        if (matrix)
+            matrix->mapRect(&bounds);
+        this->damage(&bounds, nullptr);
+        SkNWayCanvas::onDrawDrawable(drawable, matrix);
+    }
+
+private:
+    // Adds local bounds, outset by paint, to the damage. If bounds is nullptr
+    // or paint bounds cannot be computed, adds the device clip bounds.
+    void damage(const SkRect* bounds, const SkPaint* paint) {
+        if (!fEnabled)
+            return;
+        SkIRect device = this->getDeviceClipBounds();
+        if (bounds && (!paint || paint->canComputeFastBounds())) {
+            SkRect storage;
+            const SkRect& local = (paint) ?
+                paint->computeFastBounds(*bounds, &storage) : *bounds;
+            // Outset for antialiasing and hairlines.
+            auto mapped = this->getTotalMatrix().mapRect(local).roundOut()
+                .makeOutset(1, 1);
+            if (!device.intersect(mapped))
+                return;
+        }
+        fDamage.op(device, SkRegion::kUnion_Op);
+    }
+
+    bool fEnabled;
+    SkRegion fDamage;
+};
+
+// Damage canvases of surfaces, erased when the Python surface is deleted.
+std::unordered_map<const SkSurface*, std::unique_ptr<DamageCanvas>>&
+DamageCanvases() {
+    static std::unordered_map<
+        const SkSurface*, std::unique_ptr<DamageCanvas>> canvases;
+    return canvases;
+}
+
+DamageCanvas* GetDamageCanvas(SkSurface& surface) {
+    auto& canvases = DamageCanvases();
+    auto it = canvases.find(&surface);
+    return (it != canvases.end()) ? it->second.get() : nullptr;
+}
+
+DamageCanvas* MakeDamageCanvas(SkSurface& surface) {
+    if (auto canvas = GetDamageCanvas(surface))
+        return canvas;
+    const SkSurface* key = &surface;
+    py::object self = py::cast(&surface, py::return_value_policy::reference);
+    py::cpp_function callback([key] (py::handle weakref) {
+        DamageCanvases().erase(key);
+        weakref.dec_ref();
+    });
+    py::weakref(self, callback).release();
+    auto canvas = new DamageCanvas(surface.getCanvas());
+    DamageCanvases()[key].reset(canvas);
+    return canvas;
+}
+
+}  // namespace
+
 void initSurface(py::module &m) {
 
 py::enum_<SkBackingFit>(m, "BackingFit", R"docstring(
@@ -110,7 +402,7 @@ py::class_<SkSurfaceCharacterization>(m, "SurfaceCharacterization")
     ;
 
 py::class_<SkSurface, sk_sp<SkSurface>> surface(
-    m, "Surface", py::buffer_protocol(), R"docstring(
+    m, "Surface", R"docstring(
     :py:class:`Surface` is responsible for managing the pixels that a canvas
     draws into.
 
@@ -122,6 +414,10 @@ py::class_<SkSurface, sk_sp<SkSurface>> surface(
     there is a request for a new surface, and either of the requested dimensions
     are zero, then nullptr will be returned.
 
+    Pixels of a raster surface are exported without copy through
+    ``__array_interface__`` and DLPack as an array of shape (height, width,
+    channels); see :py:class:`Pixmap`.
+
     .. rubric:: Classes
 
     .. autosummary::
@@ -182,6 +478,17 @@ py::enum_<SkSurface::FlushFlags>(surface, "FlushFlags", py::arithmetic())
     .value("kSyncCpu_FlushFlag", SkSurface::FlushFlags::kSyncCpu_FlushFlag)
     .export_values();
 
+DefinePixelExport(surface,
+    [] (SkSurface& self) {
+        // Exported pixels may be written, so detach them from snapshots
+        // before taking their address.
+        self.notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+        SkPixmap pixmap;
+        if (!self.peekPixels(&pixmap))
+            throw std::runtime_error("Surface is not raster-backed.");
+        return pixmap;
+    }, false);
+
 surface
     .def(py::init(&SkSurface::MakeRasterN32Premul),
         R"docstring(
@@ -261,9 +568,90 @@ surface
         returned is managed and owned by :py:class:`Surface`, and is deleted
         when :py:class:`Surface` is deleted.
 
+        Draws made through this :py:class:`Canvas` are not damage tracked; use
+        :py:meth:`getDamageCanvas` for that.
+
         :return: drawing :py:class:`Canvas` for :py:class:`Surface`
         )docstring",
         py::return_value_policy::reference)
+    .def("getDamageCanvas",
+        [] (SkSurface& surface) -> SkCanvas* {
+            auto canvas = GetDamageCanvas(surface);
+            if (!canvas)
+                throw std::runtime_error("Damage tracking is not enabled.");
+            return canvas;
+        },
+        R"docstring(
+        Returns :py:class:`Canvas` that forwards to :py:meth:`getCanvas` and
+        records damage.
+
+        The returned :py:class:`Canvas` only forwards drawing commands; it has
+        no pixels of its own, so :py:meth:`Canvas.getSurface`,
+        :py:meth:`Canvas.readPixels` and :py:meth:`Canvas.peekPixels` do not
+        work on it. Query :py:meth:`getCanvas` instead.
+
+        Subsequent calls return the same :py:class:`Canvas`, which is deleted
+        when :py:class:`Surface` is deleted.
+
+        :return: damage tracking :py:class:`Canvas` for :py:class:`Surface`
+        :raises RuntimeError: if :py:meth:`setDamageTracking` was never called
+        )docstring",
+        py::return_value_policy::reference_internal)
+    .def("setDamageTracking",
+        [] (SkSurface& surface, bool enabled) {
+            if (auto canvas = GetDamageCanvas(surface))
+                canvas->setEnabled(enabled);
+            else if (enabled)
+                MakeDamageCanvas(surface);
+        },
+        R"docstring(
+        Enables or disables accumulation of damage, the device-space bounds of
+        draws made through :py:meth:`getDamageCanvas`.
+
+        Damage is conservative: bounds are outset for antialiasing, and draws
+        whose bounds cannot be computed, such as :py:meth:`Canvas.drawPaint`
+        or draws with image filters, damage the whole clip.
+
+        Only draws made through :py:meth:`getDamageCanvas` are tracked. Pixels
+        changed any other way are not, including draws through
+        :py:meth:`getCanvas`, :py:meth:`writePixels`, :py:meth:`draw`,
+        :py:meth:`Picture.playbackAsync` and the reset of a surface returned
+        to a :py:class:`SurfacePool`.
+
+        Redraw only what changed each frame::
+
+            surface.setDamageTracking(True)
+            canvas = surface.getDamageCanvas()
+            ...
+            widget.draw(canvas)
+            damage = surface.takeDamage()
+            if not damage.isEmpty():
+                it = skia.Region.Iterator(damage)
+                while not it.done():
+                    present(surface.makeImageSnapshot(it.rect()))
+                    it.next()
+
+        :param bool enabled: whether draws are tracked
+        )docstring",
+        py::arg("enabled") = true)
+    .def("takeDamage",
+        [] (SkSurface& surface) {
+            auto canvas = GetDamageCanvas(surface);
+            if (!canvas)
+                throw std::runtime_error("Damage tracking is not enabled.");
+            return canvas->takeDamage();
+        },
+        R"docstring(
+        Returns the damage accumulated since tracking was enabled or since the
+        previous call, and resets it.
+
+        The damage can be passed to :py:meth:`Picture.playbackRegion` to
+        re-render a scene only where it changed.
+
+        :return: damaged pixels
+        :rtype: skia.Region
+        :raises RuntimeError: if :py:meth:`setDamageTracking` was never called
+        )docstring")
     .def("makeSurface",
         py::overload_cast<const SkImageInfo&>(&SkSurface::makeSurface),
         R"docstring(
@@ -664,9 +1052,77 @@ surface
     // .def_static("MakeRasterDirectReleaseProc",
     //     &SkSurface::MakeRasterDirectReleaseProc,
     //     "Allocates raster SkSurface.")
+    .def_static("MakeRasterShared",
+        [] (const SkImageInfo& imageInfo, py::object shared, size_t rowBytes,
+            const SkSurfaceProps* surfaceProps) {
+            rowBytes = (rowBytes == 0) ? imageInfo.minRowBytes() : rowBytes;
+            auto context = OpenSharedBuffer(
+                shared, imageInfo.computeByteSize(rowBytes), true);
+            auto surface = SkSurface::MakeRasterDirectReleaseProc(
+                imageInfo, context->info.ptr, rowBytes,
+                [] (void*, void* context) { ReleaseSharedBuffer(context); },
+                context, surfaceProps);
+            if (!surface) {
+                delete context;
+                throw std::runtime_error("Failed to create Surface");
+            }
+            return surface;
+        },
+        R"docstring(
+        Allocates raster :py:class:`Surface` that draws directly into memory
+        shared between processes.
+
+        shared is the name of an existing
+        :py:class:`multiprocessing.shared_memory.SharedMemory` block, a
+        :py:class:`~multiprocessing.shared_memory.SharedMemory` object, or any
+        writable buffer object such as :py:class:`mmap.mmap` over a memfd. The
+        memory stays mapped until :py:class:`Surface` is deleted; the caller
+        remains responsible for unlinking the shared memory block.
+
+        A typical use is to create the block in a parent process, draw into it
+        from a worker process, and read the result in the parent with
+        :py:meth:`Image.MakeFromShared` without copy::
+
+            # parent
+            shm = SharedMemory(create=True, size=info.computeMinByteSize())
+            # worker
+            surface = skia.Surface.MakeRasterShared(info, shm.name)
+            surface.getCanvas().drawPicture(picture)
+            # parent
+            image = skia.Image.MakeFromShared(shm.name, info)
+
+        :param skia.ImageInfo imageInfo: width, height, :py:class:`ColorType`,
+            :py:class:`AlphaType`, :py:class:`ColorSpace`, of raster surface;
+            width and height must be greater than zero
+        :param shared: shared memory name, object, or buffer
+        :param int rowBytes: interval from one :py:class:`Surface` row to the
+            next; may be zero
+        :param skia.SurfaceProps surfaceProps: LCD striping orientation and
+            setting for device independent fonts; may be nullptr
+        :return: :py:class:`Surface` drawing into shared memory
+        )docstring",
+        py::arg("imageInfo"), py::arg("shared"), py::arg("rowBytes") = 0,
+        py::arg("surfaceProps") = nullptr)
     .def_static("MakeRaster",
-        py::overload_cast<const SkImageInfo&, size_t, const SkSurfaceProps*>(
-            &SkSurface::MakeRaster),
+        [] (const SkImageInfo& imageInfo, size_t rowBytes,
+            const SkSurfaceProps* surfaceProps, PixelAllocator* allocator) {
+            if (!allocator)
+                return SkSurface::MakeRaster(imageInfo, rowBytes, surfaceProps);
+            SkBitmap bitmap;
+            if (!bitmap.setInfo(imageInfo, rowBytes) ||
+                !bitmap.tryAllocPixels(allocator))
+                return sk_sp<SkSurface>();
+            auto pixelRef = SkRef(bitmap.pixelRef());
+            auto surface = SkSurface::MakeRasterDirectReleaseProc(
+                imageInfo, bitmap.getPixels(), bitmap.rowBytes(),
+                [] (void*, void* pixelRef) {
+                    static_cast<SkPixelRef*>(pixelRef)->unref();
+                },
+                pixelRef, surfaceProps);
+            if (!surface)
+                pixelRef->unref();
+            return surface;
+        },
         R"docstring(
         Allocates raster :py:class:`Surface`.
 
@@ -684,6 +1140,9 @@ surface
 
         If rowBytes is zero, a suitable value will be chosen internally.
 
+        If allocator is given, pixel memory comes from allocator and is not
+        zeroed unless the allocator zeroes it.
+
         :param skia.ImageInfo imageInfo: width, height, :py:class:`ColorType`,
             :py:class:`AlphaType`, :py:class:`ColorSpace`, of raster surface;
             width and height must be greater than zero
@@ -691,11 +1150,13 @@ surface
             next; may be zero
         :param skia.SurfaceProps surfaceProps: LCD striping orientation and
             setting for device independent fonts; may be nullptr
+        :param skia.PixelAllocator allocator: allocator of pixel memory; may
+            be `None`
         :return: :py:class:`Surface` if all parameters are valid; otherwise,
             nullptr
         )docstring",
         py::arg("imageInfo"), py::arg("rowBytes") = 0,
-        py::arg("surfaceProps") = nullptr)
+        py::arg("surfaceProps") = nullptr, py::arg("allocator") = nullptr)
     // .def_static("MakeRaster",
     //     py::overload_cast<const SkImageInfo&, const SkSurfaceProps*>(
     //         &SkSurface::MakeRaster),
@@ -0,0 +1,273 @@
+#include "common.h"
+#include <mutex>
+#include <unordered_set>
+
+// Cache of raster surfaces of one ImageInfo. Released surfaces are reset by
+// erasing only their dirty bounds, instead of allocating and zeroing fresh
+// pixels for every frame. Each surface canvas is handed out with one save()
+// on its stack, so that matrix and clip changes are undone by restoring it.
+class SurfacePool {
+public:
+    struct Stats {
+        size_t allocated = 0;
+        size_t reused = 0;
+        size_t released = 0;
+        size_t discarded = 0;
+    };
+
+    SurfacePool(const SkImageInfo& info, size_t maxCached,
+                const SkSurfaceProps* props, SkColor4f clearColor)
+        : fInfo(info), fMaxCached(maxCached),
+          fProps(props ? new SkSurfaceProps(*props) : nullptr),
+          fClearColor(clearColor) {}
+
+    sk_sp<SkSurface> acquire() {
+        sk_sp<SkSurface> surface;
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            if (!fCached.empty()) {
+                surface = std::move(fCached.back());
+                fCached.pop_back();
+                fStats.reused++;
+            }
+        }
+        if (!surface) {
+            surface = SkSurface::MakeRaster(fInfo, fProps.get());
+            if (!surface)
+                throw std::runtime_error("Failed to allocate Surface.");
+            if (fClearColor != SkColors::kTransparent)
+                this->erase(surface.get(), nullptr);
+            surface->getCanvas()->save();
+            std::lock_guard<std::mutex> lock(fMutex);
+            fStats.allocated++;
+        }
+        std::lock_guard<std::mutex> lock(fMutex);
+        fOutstanding.insert(surface.get());
+        return surface;
+    }
+
+    // Returns surface to the pool, erasing dirty bounds, or all pixels if
+    // dirty is nullptr. Call without the GIL.
+    void release(sk_sp<SkSurface> surface, const SkIRect* dirty) {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            if (!fOutstanding.erase(surface.get()))
+                throw py::value_error("Surface was not acquired from pool");
+            fStats.released++;
+            if (fCached.size() >= fMaxCached) {
+                fStats.discarded++;
+                return;
+            }
+        }
+        auto canvas = surface->getCanvas();
+        canvas->restoreToCount(1);
+        canvas->save();
+        this->erase(surface.get(), dirty);
+        std::lock_guard<std::mutex> lock(fMutex);
+        fCached.push_back(std::move(surface));
+    }
+
+    void purge() {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fCached.clear();
+    }
+
+    const SkImageInfo& info() const { return fInfo; }
+
+    py::dict stats() const {
+        std::lock_guard<std::mutex> lock(fMutex);
+        py::dict stats;
+        stats["allocated"] = fStats.allocated;
+        stats["reused"] = fStats.reused;
+        stats["released"] = fStats.released;
+        stats["discarded"] = fStats.discarded;
+        stats["outstanding"] = fOutstanding.size();
+        stats["cached"] = fCached.size();
+        stats["cachedBytes"] = fCached.size() * fInfo.computeMinByteSize();
+        return stats;
+    }
+
+private:
+    void erase(SkSurface* surface, const SkIRect* dirty) {
+        // Detach pixels from snapshots taken by the previous user.
+        surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+        SkPixmap pixmap;
+        if (surface->peekPixels(&pixmap))
+            pixmap.erase(fClearColor, dirty);
+    }
+
+    SkImageInfo fInfo;
+    size_t fMaxCached;
+    std::unique_ptr<SkSurfaceProps> fProps;
+    SkColor4f fClearColor;
+    mutable std::mutex fMutex;
+    std::vector<sk_sp<SkSurface>> fCached;
+    std::unordered_set<SkSurface*> fOutstanding;
+    Stats fStats;
+};
+
+// Surface handed out by SurfacePool, returned on release(), context exit or
+// deletion.
+struct SurfaceLease {
+    SurfaceLease(std::shared_ptr<SurfacePool> pool, sk_sp<SkSurface> surface)
+        : pool(std::move(pool)), surface(std::move(surface)) {}
+    SurfaceLease(SurfaceLease&&) = default;
+
+    ~SurfaceLease() {
+        try {
+            this->release();
+        } catch (std::exception&) {
+            // Nothing to report to from a destructor.
+        }
+    }
+
+    void release() {
+        if (!surface)
+            return;
+        auto pool = std::move(this->pool);
+        auto surface = std::move(this->surface);
+        py::gil_scoped_release release;
+        pool->release(std::move(surface), dirty.get());
+    }
+
+    std::shared_ptr<SurfacePool> pool;
+    sk_sp<SkSurface> surface;
+    std::unique_ptr<SkIRect> dirty;
+};
+
+void initSurfacePool(py::module &m) {
+py::class_<SurfacePool, std::shared_ptr<SurfacePool>> pool(
+    m, "SurfacePool", R"docstring(
+    :py:class:`SurfacePool` hands out recycled raster :py:class:`Surface`
+    objects of one :py:class:`ImageInfo`, to avoid allocating and zeroing
+    pixels for every frame.
+
+    Released surfaces are reset by erasing only their dirty bounds, and their
+    :py:class:`Canvas` matrix and clip are restored::
+
+        pool = skia.SurfacePool(skia.ImageInfo.MakeN32Premul(3840, 2160))
+
+        with pool.acquire() as lease:
+            canvas = lease.surface.getCanvas()
+            canvas.drawRect(skia.Rect(100, 100, 200, 200), paint)
+            data = lease.surface.makeImageSnapshot().encodeToData()
+            lease.dirty = skia.IRect(100, 100, 200, 200)
+
+        lease = pool.acquire()
+        lease.surface.getCanvas().drawRect(
+            skia.Rect(100, 100, 200, 200), paint)
+        lease.dirty = skia.IRect(100, 100, 200, 200)
+        lease.release()
+
+    Do not use a surface after its lease is released. Snapshots taken from
+    the surface remain valid.
+
+    .. rubric:: Classes
+
+    .. autosummary::
+        :nosignatures:
+
+        ~SurfacePool.Lease
+    )docstring");
+
+py::class_<SurfaceLease>(pool, "Lease", R"docstring(
+    A :py:class:`Surface` acquired from :py:class:`SurfacePool`.
+
+    The surface returns to the pool on :py:meth:`release`, on exit of the
+    ``with`` statement, or when the lease is deleted.
+    )docstring")
+    .def_property_readonly("surface",
+        [] (const SurfaceLease& lease) {
+            if (!lease.surface)
+                throw std::runtime_error("Lease is released.");
+            return lease.surface;
+        },
+        R"docstring(
+        The leased :py:class:`Surface`.
+        )docstring")
+    .def_property("dirty",
+        [] (const SurfaceLease& lease) -> py::object {
+            if (!lease.dirty)
+                return py::none();
+            return py::cast(*lease.dirty);
+        },
+        [] (SurfaceLease& lease, const SkIRect* dirty) {
+            lease.dirty.reset(dirty ? new SkIRect(*dirty) : nullptr);
+        },
+        R"docstring(
+        Bounds of pixels drawn while leased, erased on release. If `None`, the
+        default, the whole surface is erased.
+        )docstring")
+    .def("release", &SurfaceLease::release,
+        R"docstring(
+        Returns the surface to the pool. Does nothing if already released.
+        )docstring")
+    .def("__enter__",
+        [] (py::object self) {
+            if (!self.cast<const SurfaceLease&>().surface)
+                throw std::runtime_error("Lease is released.");
+            return self;
+        })
+    .def("__exit__",
+        [] (SurfaceLease& lease, py::args) { lease.release(); })
+    ;
+
+pool
+    .def(py::init(
+        [] (const SkImageInfo& info, size_t maxCached,
+            const SkSurfaceProps* surfaceProps, const SkColor4f& clearColor) {
+            if (info.isEmpty())
+                throw py::value_error("info must not be empty");
+            return std::make_shared<SurfacePool>(
+                info, maxCached, surfaceProps, clearColor);
+        }),
+        R"docstring(
+        Creates an empty pool.
+
+        :param skia.ImageInfo info: width, height, :py:class:`ColorType`,
+            :py:class:`AlphaType`, :py:class:`ColorSpace` of surfaces
+        :param int maxCached: maximum number of released surfaces kept for
+            reuse; surfaces released beyond this are deleted
+        :param skia.SurfaceProps surfaceProps: LCD striping orientation and
+            setting for device independent fonts; may be `None`
+        :param skia.Color4f clearColor: color that pixels are reset to
+        )docstring",
+        py::arg("info"), py::arg("maxCached") = 4,
+        py::arg("surfaceProps") = nullptr,
+        py::arg("clearColor") = SkColors::kTransparent)
+    .def("acquire",
+        [] (std::shared_ptr<SurfacePool> pool) {
+            return SurfaceLease(pool, pool->acquire());
+        },
+        R"docstring(
+        Returns a :py:class:`SurfacePool.Lease` of a cached surface, or of a
+        newly allocated surface if none is cached.
+
+        :rtype: skia.SurfacePool.Lease
+        )docstring")
+    .def("purge", &SurfacePool::purge,
+        R"docstring(
+        Deletes all cached surfaces. Leased surfaces are unaffected.
+        )docstring")
+    .def("info", &SurfacePool::info,
+        R"docstring(
+        Returns :py:class:`ImageInfo` of surfaces.
+        )docstring")
+    .def("stats", &SurfacePool::stats,
+        R"docstring(
+        Returns pool statistics to help size maxCached.
+
+        The dict has the following keys:
+
+        - ``allocated``: surfaces allocated
+        - ``reused``: acquisitions served from the cache
+        - ``released``: surfaces returned
+        - ``discarded``: released surfaces deleted because the cache was full
+        - ``outstanding``: surfaces currently leased
+        - ``cached``: surfaces currently cached
+        - ``cachedBytes``: pixel memory of cached surfaces
+
+        :rtype: dict
+        )docstring")
+    ;
+}
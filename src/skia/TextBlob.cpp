@@ -299,6 +299,19 @@ textblob
         py::arg("data"))
     ;
 
+DefinePickle(textblob,
+    [] (const SkTextBlob& textblob, int protocol) {
+        return PickleData(textblob.serialize(SkSerialProcs()), protocol);
+    },
+    [] (py::buffer state) {
+        auto data = DataFromBuffer(state);
+        auto textblob = SkTextBlob::Deserialize(
+            data->data(), data->size(), SkDeserialProcs());
+        if (!textblob)
+            throw py::value_error("Invalid data");
+        return textblob;
+    });
+
 py::class_<SkTextBlobBuilder> textblobbuilder(m, "TextBlobBuilder", R"docstring(
     Helper class for constructing :py:class:`TextBlob`.
     )docstring");
@@ -3,6 +3,7 @@
 
 #include <pybind11/pybind11.h>
 #include <skia.h>
+#include <functional>
 
 namespace py = pybind11;
 
@@ -17,4 +18,218 @@ sk_sp<T> CloneFlattenable(const T& flattenable) {
 sk_sp<SkColorSpace> CloneColorSpace(const SkColorSpace* cs);
 sk_sp<SkImage> CloneImage(const SkImage& image);
 
+// Wraps the memory of a buffer object in SkData without copy. The buffer is
+// kept exported until the returned SkData is destroyed.
+sk_sp<SkData> DataFromBuffer(py::buffer b);
+
+// Keeps a Python buffer exported, and its owner alive, while Skia uses the
+// memory. Must be deleted with the GIL held; see ReleaseSharedBuffer.
+struct SharedBuffer {
+    py::object owner;
+    py::buffer_info info;
+};
+
+// Opens memory shared between processes. source is the name of a
+// multiprocessing.shared_memory.SharedMemory block, an object with a buf
+// attribute such as SharedMemory itself, or any buffer object such as mmap.
+SharedBuffer* OpenSharedBuffer(
+    py::object source, size_t required, bool writable);
+
+// Release proc for Skia objects created over SharedBuffer. Acquires the GIL.
+void ReleaseSharedBuffer(void* context);
+
+// SkBitmap::Allocator that installs memory from allocate() as pixels, freed by
+// the release proc of the allocation. Subclasses are defined in Bitmap.cpp.
+class PixelAllocator : public SkBitmap::Allocator {
+public:
+    bool allocPixelRef(SkBitmap* bitmap) override;
+
+protected:
+    struct Allocation {
+        void* pixels;
+        void (*release)(void* pixels, void* context);
+        void* context;
+    };
+
+    // Returns at least size bytes of memory, or pixels of nullptr on failure.
+    virtual Allocation allocate(size_t size) = 0;
+};
+
+// Thread pool that runs the work of asynchronous bindings.
+SkExecutor& AsyncExecutor();
+
+// Calls fn(i) for each i in [0, count) on AsyncExecutor and the calling
+// thread, and returns when all calls are done. Call without the GIL; fn must
+// not throw.
+void ParallelFor(size_t count, std::function<void(size_t)> fn);
+
+// Calls fn(src, &dst) for each path without the GIL, in parallel for long
+// lists, and returns a tuple of the list of results and an (N, 4) float32
+// array of their bounds. Defined in Path.cpp; fn must not throw.
+py::tuple MapPaths(const std::vector<SkPath>& paths,
+                   std::function<void(const SkPath&, SkPath*)> fn);
+
+// Event loop and future of a pending asynchronous call. Must be deleted with
+// the GIL held.
+struct AsyncContext {
+    py::object loop;
+    py::object future;
+};
+
+// Returns a context with a new future of the running event loop, or throws
+// if no loop is running. The call counts as pending until EndAsync(); at
+// interpreter exit, pending calls are waited for before finalization, so that
+// workers never acquire the GIL of a finalizing interpreter.
+AsyncContext* MakeAsyncContext();
+
+// Marks a call started by MakeAsyncContext() as finished. Call without the
+// GIL, after the context is resolved.
+void EndAsync();
+
+// Resolves the future of context on its event loop thread, with result if
+// error is empty, or RuntimeError(error) otherwise, and deletes context.
+// Requires the GIL.
+void ResolveAsync(
+    AsyncContext* context, py::object result, const std::string& error);
+
+// Runs work() on AsyncExecutor without the GIL, and returns an asyncio.Future
+// of the running event loop that resolves to the result converted to Python.
+// Throws outside a running loop. work must not capture Python objects;
+// exceptions it throws fail the future.
+template <typename Work>
+py::object RunAsync(Work work) {
+    auto context = MakeAsyncContext();
+    py::object future = context->future;
+    AsyncExecutor().add([context, work] () {
+        using Result = decltype(work());
+        std::unique_ptr<Result> result;
+        std::string error;
+        try {
+            result.reset(new Result(work()));
+        } catch (std::exception& e) {
+            error = (*e.what()) ? e.what() : "Unknown error";
+        }
+        {
+            py::gil_scoped_acquire acquire;
+            py::object value;
+            if (result) {
+                try {
+                    value = py::cast(std::move(*result));
+                } catch (py::error_already_set& e) {
+                    error = e.what();
+                }
+            }
+            ResolveAsync(context, value, error);
+        }
+        EndAsync();
+    });
+    return future;
+}
+
+// Returns the __array_interface__ of pixels as an (H, W, C) array.
+py::dict PixmapArrayInterface(const SkPixmap& pixmap, bool readonly);
+
+// Returns a DLPack capsule of pixels as an (H, W, C) tensor. owner is kept
+// alive until the consumer releases the tensor. maxVersion, copy and device
+// are the __dlpack__ arguments of the consumer. Read-only pixels are exported
+// flagged read-only in a versioned capsule, or copied; otherwise, throws
+// BufferError.
+py::object PixmapDLPack(const SkPixmap& pixmap, py::object owner,
+                        bool readonly, py::object maxVersion,
+                        py::object copy, py::object device);
+
+// Adds zero-copy export of pixels to cls: __array_interface__, __dlpack__ and
+// __dlpack_device__. getPixmap(T&) returns the CPU pixels of the object, or
+// throws if there are none. The exported arrays keep the object alive.
+template <typename Class, typename GetPixmap>
+void DefinePixelExport(Class& cls, GetPixmap getPixmap, bool readonly) {
+    using T = typename Class::type;
+    cls.def_property_readonly("__array_interface__",
+        [getPixmap, readonly] (T& self) {
+            return PixmapArrayInterface(getPixmap(self), readonly);
+        },
+        "NumPy array interface of pixels with shape (height, width, "
+        "channels).");
+    cls.def("__dlpack__",
+        [getPixmap, readonly] (py::object self, py::object stream,
+                               py::object max_version, py::object dl_device,
+                               py::object copy) {
+            return PixmapDLPack(getPixmap(self.cast<T&>()), self, readonly,
+                                max_version, copy, dl_device);
+        },
+        (readonly) ?
+            R"docstring(
+            Exports pixels as a DLPack capsule with shape (height, width,
+            channels).
+
+            Pixels are exported without copy as a read-only DLPack 1.0
+            tensor. Consumers of older DLPack versions must pass copy=True.
+
+            :param stream: ignored; pixels are in CPU memory
+            :param max_version: highest DLPack version of the consumer
+            :param dl_device: device to export to; only CPU is supported
+            :param copy: if true, export a copy of pixels
+            )docstring" :
+            R"docstring(
+            Exports pixels as a DLPack capsule with shape (height, width,
+            channels), without copy unless copy is true.
+
+            :param stream: ignored; pixels are in CPU memory
+            :param max_version: highest DLPack version of the consumer
+            :param dl_device: device to export to; only CPU is supported
+            :param copy: if true, export a copy of pixels
+            )docstring",
+        py::arg("stream") = py::none(),
+        py::arg("max_version") = py::none(),
+        py::arg("dl_device") = py::none(), py::arg("copy") = py::none());
+    cls.def("__dlpack_device__",
+        [] (const T&) { return py::make_tuple(1, 0); },
+        R"docstring(
+        Returns the DLPack device of pixels, which is always CPU.
+        )docstring");
+}
+
+// Returns serialized data as a picklable object. For pickle protocol 5 or
+// later, this is a PickleBuffer that can be transferred out-of-band without
+// copy; otherwise, a bytes copy.
+py::object PickleData(sk_sp<SkData> data, int protocol);
+
+// Adds pickle support to cls. getstate(const T&, int protocol) returns the
+// picklable state of the object, and setstate(py::object state) returns the
+// reconstructed object. Objects are always reconstructed as the class of cls.
+template <typename Class, typename GetState, typename SetState>
+void DefinePickle(Class& cls, GetState getstate, SetState setstate) {
+    using T = typename Class::type;
+    py::object type = cls;
+    cls.def(py::pickle(
+        [getstate] (const T& self) { return getstate(self, 4); },
+        setstate));
+    cls.def("__reduce_ex__",
+        [type, getstate] (const T& self, int protocol) {
+            return py::make_tuple(
+                py::module::import("copyreg").attr("__newobj__"),
+                py::make_tuple(type),
+                getstate(self, protocol));
+        },
+        py::arg("protocol"));
+}
+
+// Adds pickle support to SkFlattenable subclasses based on serialize() and
+// T::Deserialize().
+template <typename Class>
+void DefineFlattenablePickle(Class& cls) {
+    using T = typename Class::type;
+    DefinePickle(cls,
+        [] (const T& self, int protocol) {
+            return PickleData(self.serialize(), protocol);
+        },
+        [] (py::buffer state) {
+            auto data = DataFromBuffer(state);
+            auto flattenable = T::Deserialize(data->data(), data->size());
+            if (!flattenable)
+                throw py::value_error("Invalid data");
+            return flattenable;
+        });
+}
+
 #endif  // _COMMON_H_
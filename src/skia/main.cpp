@@ -1,4 +1,6 @@
 #include "common.h"
+#include <algorithm>
+#include <cstdlib>
 
 #define STRING(s) #s
 
@@ -9,6 +11,8 @@ void initCanvas(py::module &);
 void initColor(py::module &);
 void initColorSpace(py::module &);
 void initData(py::module &);
+void initDocument(py::module &);
+void initDrawList(py::module &);
 void initGrContext(py::module &);
 void initFont(py::module &);
 void initImage(py::module &);
@@ -16,6 +20,7 @@ void initImageInfo(py::module &);
 void initMatrix(py::module &);
 void initPaint(py::module &);
 void initPath(py::module &);
+void initPathMeasure(py::module &);
 void initPicture(py::module &);
 void initPixmap(py::module &);
 void initPoint(py::module &);
@@ -23,16 +28,155 @@ void initRect(py::module &);
 void initRefCnt(py::module &);
 void initRegion(py::module &);
 void initSize(py::module &);
+void initStream(py::module &);
 void initSurface(py::module &);
+void initSurfacePool(py::module &);
 void initTextBlob(py::module &);
 void initVertices(py::module &);
 
+// Bindings registered on first access to one of their names. A group can be
+// deferred only when no eagerly registered binding returns its types or uses
+// them as default arguments, because pybind11 converts those at call or
+// definition time. GrContext does not qualify, as Image and Surface use Gr
+// enums for default arguments.
+struct LazyGroup {
+    std::vector<std::string> names;
+    std::vector<void (*)(py::module &)> inits;
+    bool loaded;
+};
+
+std::vector<LazyGroup>& LazyGroups() {
+    static std::vector<LazyGroup> groups = {
+        {
+            {"FontStyle", "FontArguments", "Typeface", "FontStyleSet",
+             "FontMgr", "FontHinting", "TextEncoding", "Font", "FontMetrics",
+             "TextBlob", "TextBlobBuilder",
+             // Values of FontHinting and TextEncoding exported to the module.
+             "kNone", "kSlight", "kNormal", "kFull", "kUTF8", "kUTF16",
+             "kUTF32", "kGlyphID"},
+            {initFont, initTextBlob}, false
+        },
+        {
+            {"Picture", "Drawable", "BBHFactory", "BBoxHierarchy",
+             "PictureRecorder"},
+            {initPicture}, false
+        },
+        {{"Vertices"}, {initVertices}, false},
+        {{"DrawList"}, {initDrawList}, false},
+        {{"Document", "PDF"}, {initDocument}, false},
+        {{"SurfacePool"}, {initSurfacePool}, false},
+        {
+            {"PathMeasure", "ContourMeasure", "ContourMeasureIter"},
+            {initPathMeasure}, false
+        },
+    };
+    return groups;
+}
+
+void LoadLazyGroup(py::module &m, LazyGroup& group) {
+    if (group.loaded)
+        return;
+    group.loaded = true;
+    for (auto init : group.inits)
+        init(m);
+}
+
+void LoadLazyGroups(py::module &m) {
+    for (auto& group : LazyGroups())
+        LoadLazyGroup(m, group);
+}
+
+// Setting SKIA_PYTHON_EAGER_IMPORT registers everything at import, in
+// dependency order, so that docstring signatures use Python type names.
+// Module __getattr__ (PEP 562) requires Python 3.7, so older interpreters
+// always register everything at import.
+bool IsLazyImport() {
+#if PY_VERSION_HEX < 0x03070000
+    return false;
+#else
+    const char* eager = std::getenv("SKIA_PYTHON_EAGER_IMPORT");
+    return !eager || !*eager || std::string(eager) == "0";
+#endif
+}
+
+void initLazy(py::module &m) {
+    py::handle module = m;
+    m.attr("__getattr__") = py::cpp_function(
+        [module] (const std::string& name) -> py::object {
+            auto m = py::reinterpret_borrow<py::module>(module);
+            py::dict dict = m.attr("__dict__");
+            for (auto& group : LazyGroups()) {
+                if (std::find(group.names.begin(), group.names.end(), name) !=
+                    group.names.end()) {
+                    LoadLazyGroup(m, group);
+                    break;
+                }
+            }
+            // Unlisted public names load everything before giving up. Look up
+            // the module dict directly, as getattr would recurse here.
+            if (!dict.contains(name) && !name.empty() && name[0] != '_')
+                LoadLazyGroups(m);
+            if (!dict.contains(name)) {
+                PyErr_SetString(PyExc_AttributeError,
+                    ("module 'skia' has no attribute '" + name + "'").c_str());
+                throw py::error_already_set();
+            }
+            return dict[name.c_str()];
+        }, py::arg("name"));
+    m.attr("__dir__") = py::cpp_function(
+        [module] () {
+            auto m = py::reinterpret_borrow<py::module>(module);
+            py::list names = m.attr("__dict__").attr("keys")();
+            for (auto& group : LazyGroups())
+                if (!group.loaded)
+                    for (auto& name : group.names)
+                        names.append(name);
+            names.attr("sort")();
+            return names;
+        });
+}
+
+// Sets __all__ to every public name, including lazy names not yet registered,
+// so that a star import resolves lazy names through __getattr__ instead of
+// reading only the module dict.
+void initAll(py::module &m) {
+    py::dict dict = m.attr("__dict__");
+    py::list names;
+    for (auto item : dict)
+        if (item.first.cast<std::string>()[0] != '_')
+            names.append(item.first);
+    for (auto& group : LazyGroups())
+        for (auto& name : group.names)
+            if (!dict.contains(name))
+                names.append(name);
+    names.attr("sort")();
+    m.attr("__all__") = names;
+}
+
+// pybind11 keeps registered types in process-wide internals, and this module
+// uses single-phase initialization, so only the main interpreter can load it.
+// Fail the import in sub-interpreters instead of sharing type objects across
+// interpreters.
+void CheckMainInterpreter() {
+#if PY_VERSION_HEX >= 0x03070000
+    if (PyThreadState_Get()->interp != PyInterpreterState_Main()) {
+        PyErr_SetString(PyExc_ImportError,
+            "skia does not support sub-interpreters");
+        throw py::error_already_set();
+    }
+#endif
+}
+
 // Main entry point.
 PYBIND11_MODULE(skia, m) {
+    CheckMainInterpreter();
+
     m.doc() = R"docstring(
     Python Skia binding module.
     )docstring";
 
+    const bool lazy = IsLazyImport();
+
     initRefCnt(m);
 
     initBlendMode(m);
@@ -44,25 +188,44 @@ PYBIND11_MODULE(skia, m) {
     initRegion(m);
     initMatrix(m);
     initData(m);
+    initStream(m);
 
     initBitmap(m);
-    initFont(m);
+    if (!lazy)
+        initFont(m);
     initGrContext(m);
     initImageInfo(m);
     initImage(m);
     initPaint(m);
     initPath(m);
-    initPicture(m);
+    if (!lazy) {
+        initPathMeasure(m);
+        initPicture(m);
+    }
     initPixmap(m);
-    initTextBlob(m);
-    initVertices(m);
+    if (!lazy) {
+        initTextBlob(m);
+        initVertices(m);
+    }
 
     initCanvas(m);
     initSurface(m);
+    if (!lazy) {
+        initDrawList(m);
+        initDocument(m);
+        initSurfacePool(m);
+    }
+
+    // Otherwise, text, PathMeasure, Picture, Vertices, DrawList, Document, and
+    // SurfacePool load on first use.
+    if (lazy)
+        initLazy(m);
 
 #ifdef VERSION_INFO
     m.attr("__version__") = STRING(VERSION_INFO);
 #else
     m.attr("__version__") = "dev";
 #endif
+
+    initAll(m);
 }
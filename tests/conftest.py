@@ -1,3 +1,4 @@
+import asyncio
 import contextlib
 import skia
 import pytest
@@ -103,3 +104,14 @@ def pixmap():
     info = skia.ImageInfo.MakeN32Premul(100, 100)
     data = bytearray(info.computeMinByteSize())
     yield skia.Pixmap(info, data, info.minRowBytes())
+
+
+@pytest.fixture
+def run_async():
+    def run(coroutine):
+        loop = asyncio.new_event_loop()
+        try:
+            return loop.run_until_complete(coroutine)
+        finally:
+            loop.close()
+    return run
@@ -1,5 +1,7 @@
 import skia
 import pytest
+import numpy as np
+import sys
 
 
 @pytest.fixture
@@ -15,7 +17,6 @@ def bitmap(info):
 
 
 def test_Bitmap_buffer(bitmap):
-    import numpy as np
     assert isinstance(memoryview(bitmap), memoryview)
     array = np.array(bitmap)
     assert array.ndim == 2
@@ -184,6 +185,42 @@ def test_Bitmap_allocPixels2(bitmap, info):
     bitmap.allocPixels(info)
 
 
+@pytest.mark.parametrize('allocator', [
+    skia.PixelAllocator.MakeHeap(),
+    skia.PixelAllocator.MakeHugePage(),
+    skia.PixelAllocator.MakeNUMALocal(),
+    skia.PixelAllocator.MakeArena(1 << 16),
+])
+def test_Bitmap_allocPixels_allocator(info, allocator):
+    bitmap = skia.Bitmap()
+    bitmap.allocPixels(info, allocator=allocator)
+    bitmap.eraseColor(skia.ColorRED)
+    assert bitmap.getColor(119, 79) == skia.ColorRED
+
+
+@pytest.mark.skipif(sys.platform == 'win32', reason='Heap on Windows')
+def test_Bitmap_allocPixels_huge_page_aligned(info):
+    bitmap = skia.Bitmap()
+    bitmap.allocPixels(info, allocator=skia.PixelAllocator.MakeHugePage())
+    assert np.asarray(bitmap).ctypes.data % (2 << 20) == 0
+
+
+def test_Bitmap_tryAllocPixels_factory(info):
+    buffers = []
+
+    def factory(size):
+        buffers.append(bytearray(size))
+        return buffers[-1]
+
+    allocator = skia.PixelAllocator.MakeFromFactory(factory)
+    bitmap = skia.Bitmap()
+    assert bitmap.tryAllocPixels(info, allocator=allocator)
+    bitmap.eraseColor(0xFFFFFFFF)
+    assert buffers[0][0] == 0xFF
+    failing = skia.PixelAllocator.MakeFromFactory(lambda size: bytearray(1))
+    assert not bitmap.tryAllocPixels(info, allocator=failing)
+
+
 def test_Bitmap_tryAllocN32Pixels():
     bitmap = skia.Bitmap()
     assert isinstance(bitmap.tryAllocN32Pixels(100, 100, True), bool)
@@ -268,3 +305,15 @@ def test_Bitmap_peekPixels(bitmap):
 
 def test_Bitmap_ComputeIsOpaque(bitmap):
     assert isinstance(skia.ComputeIsOpaque(bitmap), bool)
+
+
+def test_Bitmap_array_interface(bitmap):
+    interface = bitmap.__array_interface__
+    assert interface['shape'] == (80, 120, 4)
+    assert interface['typestr'] == '|u1'
+
+
+def test_Bitmap_dlpack(bitmap):
+    if not hasattr(np, 'from_dlpack'):
+        pytest.skip('NumPy does not support DLPack')
+    assert np.from_dlpack(bitmap).shape == (80, 120, 4)
@@ -1,6 +1,7 @@
 import skia
 import pytest
 import numpy as np
+import io
 
 
 @pytest.fixture(scope='session')
@@ -278,10 +279,46 @@ def test_Canvas_drawLine(canvas, args):
     canvas.drawLine(*args)
 
 
+@pytest.mark.parametrize('colors', [
+    None,
+    np.array([0xFFFF0000, 0xFF00FF00], dtype=np.uint32),
+])
+def test_Canvas_drawLines(canvas, colors):
+    lines = np.array([[0, 0, 10, 10], [10, 0, 0, 10]], dtype=np.float32)
+    canvas.drawLines(lines, skia.Paint(), colors)
+
+
 def test_Canvas_drawRect(canvas):
     canvas.drawRect(skia.Rect(10, 10), skia.Paint())
 
 
+@pytest.mark.parametrize('colors', [
+    None,
+    [0xFFFF0000, 0xFF00FF00],
+])
+def test_Canvas_drawRects(canvas, colors):
+    rects = np.array([[0, 0, 10, 10], [10, 10, 20, 20]], dtype=np.float32)
+    canvas.drawRects(rects, skia.Paint(), colors)
+
+
+def test_Canvas_drawRects_colors():
+    array = np.zeros((10, 20, 4), dtype=np.uint8)
+    canvas = skia.Canvas(array)
+    rects = np.array([[0, 0, 10, 10], [10, 0, 20, 10]])
+    colors = np.array([0xFFFFFFFF, 0xFF000000], dtype=np.uint32)
+    canvas.drawRects(rects, skia.Paint(), colors)
+    assert array[5, 5, 0] == 255
+    assert array[5, 15, 0] == 0
+    assert array[5, 15, 3] == 255
+
+
+def test_Canvas_drawRects_invalid(canvas):
+    with pytest.raises(ValueError):
+        canvas.drawRects(np.zeros((2, 3)), skia.Paint())
+    with pytest.raises(ValueError):
+        canvas.drawRects(np.zeros((2, 4)), skia.Paint(), [0xFFFFFFFF])
+
+
 def test_Canvas_drawIRect(canvas):
     canvas.drawIRect(skia.IRect(10, 10), skia.Paint())
 
@@ -294,6 +331,11 @@ def test_Canvas_drawOval(canvas):
     canvas.drawOval(skia.Rect(10, 10), skia.Paint())
 
 
+def test_Canvas_drawOvals(canvas):
+    ovals = np.array([[0, 0, 10, 20], [10, 10, 30, 20]], dtype=np.float32)
+    canvas.drawOvals(ovals, skia.Paint(), [0xFFFF0000, 0xFF00FF00])
+
+
 def test_Canvas_drawRRect(canvas):
     canvas.drawRRect(skia.RRect(), skia.Paint())
 
@@ -310,6 +352,11 @@ def test_Canvas_drawCircle(canvas, args):
     canvas.drawCircle(*args)
 
 
+def test_Canvas_drawCircles(canvas):
+    circles = np.array([[10, 10, 5], [20, 20, 8]], dtype=np.float32)
+    canvas.drawCircles(circles, skia.Paint(), [0xFFFF0000, 0xFF00FF00])
+
+
 def test_Canvas_drawArc(canvas):
     canvas.drawArc(skia.Rect(30, 30), 0, 90, True, skia.Paint())
 
@@ -453,6 +500,27 @@ def test_Canvas_drawAtlas(canvas, image, args):
     canvas.drawAtlas(image, *args)
 
 
+def test_Canvas_drawImageSet(image):
+    surface = skia.Surface(40, 20)
+    canvas = surface.getCanvas()
+    opaque = skia.Image(np.full((10, 10, 4), 255, dtype=np.uint8))
+    dst = np.array([[0, 0, 10, 10], [20, 0, 30, 10]], dtype=np.float32)
+    canvas.drawImageSet(
+        [opaque, opaque], None, dst,
+        matrices=np.stack([np.eye(3), np.eye(3)]),
+        alphas=np.array([1., 0.5]),
+        aaFlags=[int(skia.Canvas.kAll_QuadAAFlags), 0])
+    alpha = np.asarray(surface)[:10, :, 3]
+    assert np.all(alpha[:, :10] == 255)
+    assert np.all(np.abs(alpha[:, 20:30].astype(int) - 128) <= 1)
+    assert np.all(alpha[:, 10:20] == 0)
+    assert np.all(alpha[:, 30:] == 0)
+    canvas.drawImageSet(
+        image, np.array([[0, 0, 4, 4]]), np.array([[0, 10, 40, 20]]))
+    with pytest.raises(ValueError):
+        canvas.drawImageSet([image], None, dst)
+
+
 def test_Canvas_drawAnnotation(canvas):
     canvas.drawAnnotation(
         skia.Rect(10, 10), 'key', skia.Data(b'\x00\x00\x00\x00'))
@@ -502,3 +570,93 @@ def test_AutoCanvasRestore(canvas, doSave):
 def test_AutoCanvasRestore_with(canvas, doSave):
     with skia.AutoCanvasRestore(canvas, doSave):
         pass
+
+
+@pytest.fixture
+def overdraw_canvas():
+    return skia.OverdrawCanvas(32, 16)
+
+
+@pytest.mark.parametrize('args', [
+    (32, 16),
+    (skia.Canvas(np.zeros((16, 32, 4), dtype=np.uint8)),),
+])
+def test_OverdrawCanvas_init(args):
+    check_canvas(skia.OverdrawCanvas(*args))
+
+
+def test_OverdrawCanvas_init_picture(picture):
+    canvas = skia.OverdrawCanvas(picture)
+    assert canvas.toarray().shape == (100, 100)
+
+
+def test_OverdrawCanvas_toarray(overdraw_canvas):
+    overdraw_canvas.drawRect(skia.Rect(8, 8), skia.Paint())
+    overdraw_canvas.drawRect(skia.Rect(4, 4), skia.Paint())
+    array = overdraw_canvas.toarray()
+    assert array.shape == (16, 32)
+    assert array.dtype == np.uint8
+    assert array[0, 0] == 2
+    assert array[6, 6] == 1
+    assert array[12, 12] == 0
+
+
+def test_OverdrawCanvas_stats(overdraw_canvas):
+    overdraw_canvas.drawRect(skia.Rect(8, 8), skia.Paint())
+    overdraw_canvas.drawRect(skia.Rect(4, 4), skia.Paint())
+    stats = overdraw_canvas.stats()
+    assert stats['pixels'] == 32 * 16
+    assert stats['covered'] == 64
+    assert stats['overdrawn'] == 16
+    assert stats['max'] == 2
+    assert len(stats['histogram']) == 256
+
+
+@pytest.mark.parametrize('flags', [
+    0,
+    skia.SVGCanvas.kConvertTextToPaths_Flag,
+    skia.SVGCanvas.kNoPrettyXML_Flag,
+])
+def test_SVGCanvas_Make(flags):
+    f = io.BytesIO()
+    stream = skia.WStream(f)
+    canvas = skia.SVGCanvas.Make(skia.Rect(100, 100), stream, flags)
+    assert isinstance(canvas, skia.Canvas)
+    canvas.drawCircle(50, 50, 10, skia.Paint())
+    del canvas
+    stream.flush()
+    assert b'<svg' in f.getvalue()
+    assert b'</svg>' in f.getvalue()
+
+
+def test_FanOutCanvas():
+    full = skia.Surface(40, 20)
+    thumbnail = skia.Surface(20, 10)
+    inverted = skia.Surface.MakeRaster(skia.ImageInfo.Make(
+        40, 20, skia.kRGBA_8888_ColorType, skia.kPremul_AlphaType))
+    canvas = skia.FanOutCanvas(40, 20)
+    check_canvas(canvas)
+    canvas.addCanvas(full.getCanvas())
+    canvas.addCanvas(thumbnail.getCanvas(), skia.Matrix.Scale(0.5, 0.5))
+    canvas.addCanvas(
+        inverted.getCanvas(),
+        colorFilter=skia.ColorFilters.Blend(
+            skia.ColorBLUE, skia.BlendMode.kSrc))
+    assert canvas.targetCount() == 3
+    canvas.translate(20, 0)
+    canvas.drawRect(skia.Rect(20, 20), skia.Paint(skia.ColorRED))
+    canvas.removeAll()
+    assert canvas.targetCount() == 0
+    assert np.asarray(full)[10, 30, 3] == 255
+    assert np.asarray(full)[10, 10, 3] == 0
+    assert np.asarray(thumbnail)[5, 15, 3] == 255
+    assert np.asarray(thumbnail)[5, 5, 3] == 0
+    assert tuple(np.asarray(inverted)[10, 30]) == (0, 0, 255, 255)
+    assert full.getCanvas().getTotalMatrix().isIdentity()
+
+
+def test_FanOutCanvas_temporary_surface():
+    canvas = skia.FanOutCanvas(10, 10)
+    canvas.addCanvas(skia.Surface(10, 10).getCanvas())
+    canvas.drawPaint(skia.Paint(skia.ColorRED))
+    canvas.removeAll()
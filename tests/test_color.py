@@ -0,0 +1,80 @@
+import skia
+import pytest
+import numpy as np
+
+
+@pytest.fixture
+def colors():
+    return np.array([
+        skia.ColorRED, skia.ColorGREEN, skia.ColorBLUE,
+        skia.ColorSetARGB(0x80, 0x40, 0x20, 0x10),
+    ], dtype=np.uint32)
+
+
+def test_ColorsToRGBA(colors):
+    rgba = skia.ColorsToRGBA(colors)
+    assert rgba.dtype == np.uint8
+    assert rgba.shape == (4, 4)
+    assert tuple(rgba[0]) == (255, 0, 0, 255)
+    assert tuple(rgba[3]) == (0x40, 0x20, 0x10, 0x80)
+
+
+def test_ColorsToRGBA_shape(colors):
+    rgba = skia.ColorsToRGBA(colors.reshape(2, 2))
+    assert rgba.shape == (2, 2, 4)
+
+
+@pytest.mark.parametrize('dtype', [np.uint8, np.int32, np.float32])
+def test_ColorsFromRGBA(colors, dtype):
+    rgba = skia.ColorsToRGBA(colors).astype(dtype)
+    if dtype == np.float32:
+        rgba /= 255
+    assert np.array_equal(skia.ColorsFromRGBA(rgba), colors)
+
+
+def test_ColorsFromRGBA_raises():
+    with pytest.raises(ValueError):
+        skia.ColorsFromRGBA(np.zeros((4, 3), dtype=np.uint8))
+    with pytest.raises(ValueError):
+        skia.ColorsFromRGBA(np.array([[300, 0, 0, 255]]))
+    with pytest.raises(ValueError):
+        skia.ColorsFromRGBA(np.array([[-1, 0, 0, 255]]))
+
+
+def test_ColorsToColor4f(colors):
+    color4f = skia.ColorsToColor4f(colors)
+    assert color4f.dtype == np.float32
+    for c, expected in zip(color4f, colors):
+        expected = skia.Color4f.FromColor(int(expected))
+        assert tuple(c) == tuple(expected[i] for i in range(4))
+
+
+@pytest.mark.parametrize('n', [4, 10000])
+def test_PreMultiplyColors(n):
+    colors = np.random.randint(
+        0, 0xFFFFFFFF, n, dtype=np.uint64).astype(np.uint32)
+    pmcolors = skia.PreMultiplyColors(colors)
+    for i in range(0, n, max(1, n // 16)):
+        assert pmcolors[i] == skia.PreMultiplyColor(int(colors[i]))
+
+
+def test_UnPreMultiplyColors(colors):
+    opaque = colors[:3]
+    assert np.array_equal(
+        skia.UnPreMultiplyColors(skia.PreMultiplyColors(opaque)), opaque)
+
+
+def test_ColorsToHSV(colors):
+    hsv = skia.ColorsToHSV(colors)
+    assert hsv.shape == (4, 3)
+    assert np.allclose(hsv[1], (120, 1, 1))
+
+
+def test_HSVToColors(colors):
+    hsv = skia.ColorsToHSV(colors[:3])
+    assert np.array_equal(skia.HSVToColors(hsv), colors[:3])
+    alpha = np.array([0, 0x80, 0xFF], dtype=np.uint8)
+    assert np.array_equal(
+        skia.HSVToColors(hsv, alpha) >> 24, alpha.astype(np.uint32))
+    with pytest.raises(ValueError):
+        skia.HSVToColors(hsv, np.zeros(2, dtype=np.uint8))
@@ -1,5 +1,6 @@
 import skia
 import pytest
+import pickle
 
 
 @pytest.fixture
@@ -49,6 +50,13 @@ def test_ColorFilter_Deserialize(colorfilter):
         skia.ColorFilter.Deserialize(colorfilter.serialize()), skia.ColorFilter)
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_ColorFilter_pickle(colorfilter, protocol):
+    obj = pickle.loads(pickle.dumps(colorfilter, protocol))
+    assert isinstance(obj, skia.ColorFilter)
+    assert bytes(obj.serialize()) == bytes(colorfilter.serialize())
+
+
 def test_ColorFilters_Compose(colorfilter):
     assert isinstance(
         skia.ColorFilters.Compose(colorfilter, colorfilter),
@@ -0,0 +1,110 @@
+import skia
+import pytest
+import numpy as np
+import struct
+
+
+def make_info(width, height, ct, at=skia.kUnpremul_AlphaType, cs=None):
+    return skia.ImageInfo.Make(width, height, ct, at, cs)
+
+
+# Returns an RGB matrix/TRC ICC profile with parametric transfer functions.
+def make_icc(trc, to_xyz_d50):
+    def fixed(values):
+        return struct.pack('>%di' % len(values),
+                           *(int(round(v * 65536)) for v in values))
+    para = b'para' + bytes(4) + struct.pack('>HH', 3, 0) + fixed(trc)
+    tags = [(b'rTRC', para), (b'gTRC', para), (b'bTRC', para)]
+    for sig, column in zip((b'rXYZ', b'gXYZ', b'bXYZ'), zip(*to_xyz_d50)):
+        tags.append((sig, b'XYZ ' + bytes(4) + fixed(column)))
+    offset = 128 + 4 + 12 * len(tags)
+    table, data = b'', b''
+    for sig, tag in tags:
+        table += sig + struct.pack('>II', offset + len(data), len(tag))
+        data += tag + bytes(-len(tag) % 4)
+    size = offset + len(data)
+    header = (struct.pack('>I', size) + bytes(4) + bytes((4, 0x30, 0, 0)) +
+              b'mntrRGB XYZ ' + bytes(12) + b'acsp' + bytes(28) +
+              fixed((0.9642, 1.0, 0.8249)) + bytes(48))
+    assert len(header) == 128
+    return header + struct.pack('>I', len(tags)) + table + data
+
+
+def test_ColorSpace_MakeICC():
+    srgb_trc = (2.4, 1 / 1.055, 0.055 / 1.055, 1 / 12.92, 0.04045)
+    srgb_to_xyz_d50 = (
+        (0.436065674, 0.385147095, 0.143066406),
+        (0.222488403, 0.716873169, 0.060607910),
+        (0.013916016, 0.097076416, 0.714096069),
+    )
+    colorSpace = skia.ColorSpace.MakeICC(make_icc(srgb_trc, srgb_to_xyz_d50))
+    assert isinstance(colorSpace, skia.ColorSpace)
+    src = np.random.randint(0, 256, (8, 8, 4), dtype=np.uint8)
+    linear = make_info(8, 8, skia.kRGBA_F32_ColorType,
+        cs=skia.ColorSpace.MakeSRGBLinear())
+    expected = np.zeros((8, 8, 4), dtype=np.float32)
+    skia.ConvertPixels(
+        src, make_info(8, 8, skia.kRGBA_8888_ColorType,
+                       cs=skia.ColorSpace.MakeSRGB()),
+        expected, linear)
+    actual = np.zeros((8, 8, 4), dtype=np.float32)
+    skia.ConvertPixels(
+        src, make_info(8, 8, skia.kRGBA_8888_ColorType, cs=colorSpace),
+        actual, linear)
+    assert np.allclose(actual, expected, atol=1e-3)
+
+
+def test_ColorSpace_MakeICC_raises():
+    with pytest.raises(ValueError):
+        skia.ColorSpace.MakeICC(b'not an icc profile')
+
+
+def test_ConvertPixels_float():
+    src = np.random.randint(0, 256, (4, 8, 4), dtype=np.uint8)
+    dst = np.zeros((4, 8, 4), dtype=np.float32)
+    skia.ConvertPixels(
+        src, make_info(8, 4, skia.kRGBA_8888_ColorType),
+        dst, make_info(8, 4, skia.kRGBA_F32_ColorType))
+    assert np.allclose(dst, src / 255., atol=1e-6)
+
+
+@pytest.mark.parametrize('height', [4, 512])
+def test_ConvertPixels_swizzle(height):
+    src = np.random.randint(0, 256, (height, 512, 4), dtype=np.uint8)
+    dst = np.zeros_like(src)
+    skia.ConvertPixels(
+        src, make_info(512, height, skia.kRGBA_8888_ColorType),
+        dst, make_info(512, height, skia.kBGRA_8888_ColorType))
+    assert np.array_equal(dst, src[:, :, [2, 1, 0, 3]])
+
+
+def test_ConvertPixels_in_place():
+    pixels = np.random.rand(16, 16, 4).astype(np.float32)
+    expected = pixels.copy()
+    srgb = make_info(16, 16, skia.kRGBA_F32_ColorType)
+    linear = make_info(16, 16, skia.kRGBA_F32_ColorType,
+        cs=skia.ColorSpace.MakeSRGBLinear())
+    skia.ConvertPixels(pixels, srgb, pixels, linear)
+    assert not np.allclose(pixels, expected)
+    skia.ConvertPixels(pixels, linear, pixels, srgb)
+    assert np.allclose(pixels, expected, atol=1e-4)
+
+
+def test_ConvertPixels_raises():
+    pixels = np.zeros((4, 4, 4), dtype=np.float32)
+    with pytest.raises(ValueError):
+        skia.ConvertPixels(
+            pixels, make_info(4, 4, skia.kRGBA_F32_ColorType),
+            pixels, make_info(4, 4, skia.kRGBA_8888_ColorType))
+    with pytest.raises(ValueError):
+        skia.ConvertPixels(
+            pixels, make_info(4, 4, skia.kRGBA_F32_ColorType),
+            np.zeros((2, 2, 4), dtype=np.float32),
+            make_info(2, 2, skia.kRGBA_F32_ColorType))
+
+
+def test_ConvertPixels_Pixmap(pixmap):
+    info = pixmap.info().makeColorType(skia.kRGBA_F32_ColorType)
+    dst = skia.Pixmap(
+        info, bytearray(info.computeMinByteSize()), info.minRowBytes())
+    skia.ConvertPixels(pixmap, dst)
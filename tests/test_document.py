@@ -0,0 +1,50 @@
+import skia
+import pytest
+import io
+
+
+@pytest.fixture
+def metadata():
+    metadata = skia.PDF.Metadata()
+    metadata.fTitle = 'Title'
+    return metadata
+
+
+def test_PDF_Metadata(metadata):
+    assert metadata.fTitle == 'Title'
+    metadata.fExecutor = True
+    assert metadata.fExecutor
+
+
+@pytest.mark.parametrize('use_executor', [False, True])
+def test_PDF_MakeDocument(metadata, use_executor):
+    f = io.BytesIO()
+    metadata.fExecutor = use_executor
+    stream = skia.WStream(f)
+    with skia.PDF.MakeDocument(stream, metadata) as document:
+        assert isinstance(document, skia.Document)
+        for i in range(3):
+            canvas = document.beginPage(100, 100)
+            assert isinstance(canvas, skia.Canvas)
+            canvas.drawCircle(50, 50, 10 + i, skia.Paint())
+            document.endPage()
+    stream.flush()
+    assert f.getvalue().startswith(b'%PDF')
+
+
+def test_Document_abort():
+    stream = skia.DynamicMemoryWStream()
+    document = skia.PDF.MakeDocument(stream)
+    document.beginPage(100, 100)
+    document.abort()
+
+
+def test_Document_exit_aborts_on_error():
+    f = io.BytesIO()
+    stream = skia.WStream(f)
+    with pytest.raises(ZeroDivisionError):
+        with skia.PDF.MakeDocument(stream) as document:
+            document.beginPage(100, 100)
+            1 / 0
+    stream.flush()
+    assert not f.getvalue().rstrip().endswith(b'%%EOF')
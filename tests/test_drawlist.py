@@ -0,0 +1,55 @@
+import skia
+import pytest
+import numpy as np
+
+
+@pytest.fixture
+def drawlist():
+    ops = np.array([
+        skia.DrawList.kRect_Op,
+        skia.DrawList.kCircle_Op,
+        skia.DrawList.kLine_Op,
+        skia.DrawList.kImage_Op,
+    ], dtype=np.uint8)
+    coords = np.array([
+        [0, 0, 10, 10],
+        [20, 20, 5, 0],
+        [0, 0, 30, 30],
+        [40, 40, 0, 0],
+    ], dtype=np.float32)
+    paint = skia.Paint()
+    paint.setColor(skia.ColorRED)
+    image = skia.Image(np.zeros((4, 4, 4), dtype=np.uint8))
+    return skia.DrawList(
+        ops, coords, np.array([0, 0, -1, -1]), [paint], None, [image])
+
+
+def test_DrawList_init(drawlist):
+    assert isinstance(drawlist, skia.DrawList)
+    assert len(drawlist) == 4
+
+
+@pytest.mark.parametrize('args', [
+    (np.zeros(2), np.zeros((3, 4))),
+    (np.array([255]), np.zeros((1, 4))),
+    (np.zeros(1), np.zeros((1, 4)), np.array([1]), []),
+])
+def test_DrawList_init_invalid(args):
+    with pytest.raises((ValueError, IndexError)):
+        skia.DrawList(*args)
+
+
+def test_DrawList_FromBytes():
+    dtype = np.dtype([
+        ('op', 'u1'), ('reserved', 'u1', 3), ('paintIndex', 'i4'),
+        ('imageIndex', 'i4'), ('coords', 'f4', 4)])
+    commands = np.zeros(3, dtype=dtype)
+    commands['op'] = skia.DrawList.kOval_Op
+    commands['paintIndex'] = -1
+    commands['coords'] = [0, 0, 10, 10]
+    drawlist = skia.DrawList.FromBytes(commands.tobytes())
+    assert len(drawlist) == 3
+
+
+def test_DrawList_draw(drawlist, canvas):
+    drawlist.draw(canvas)
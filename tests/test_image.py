@@ -1,5 +1,8 @@
 import skia
 import pytest
+import numpy as np
+import pickle
+import asyncio
 
 
 def test_Image_imageInfo(image):
@@ -88,6 +91,32 @@ def test_Image_readPixels(image, use_pixmap):
             image.readPixels(info, dstPixels, dstRowBytes, 0, 0), bool)
 
 
+def test_Image_readPixelsAsync(image, run_async):
+    info = image.imageInfo().makeWH(100, 100)
+    dstPixels = bytearray(info.computeMinByteSize())
+
+    async def read():
+        return await image.readPixelsAsync(info, dstPixels)
+    assert run_async(read()) is True
+
+
+def test_Image_readPixelsAsync_no_loop(image):
+    info = image.imageInfo().makeWH(100, 100)
+    dstPixels = bytearray(info.computeMinByteSize())
+    with pytest.raises(RuntimeError):
+        image.readPixelsAsync(info, dstPixels)
+
+
+def test_Image_readPixelsAsync_readonly(image, run_async):
+    info = image.imageInfo().makeWH(100, 100)
+    dstPixels = bytes(info.computeMinByteSize())
+
+    async def read():
+        return await image.readPixelsAsync(info, dstPixels)
+    with pytest.raises(BufferError):
+        run_async(read())
+
+
 def test_Image_scalePixels(image):
     info = image.imageInfo().makeWH(100, 100)
     dstRowBytes = info.minRowBytes()
@@ -104,10 +133,51 @@ def test_Image_encodeToData(image, args):
     assert isinstance(image.encodeToData(*args), skia.Data)
 
 
+def test_Image_encodeToDataAsync(image, run_async):
+    async def encode():
+        return await asyncio.gather(*[
+            image.encodeToDataAsync() for _ in range(4)])
+    for data in run_async(encode()):
+        assert isinstance(data, skia.Data)
+
+
 def test_Image_refEncodedData(image):
     assert isinstance(image.refEncodedData(), skia.Data)
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_Image_pickle(image, protocol):
+    obj = pickle.loads(pickle.dumps(image, protocol))
+    assert isinstance(obj, skia.Image)
+    assert obj.dimensions() == image.dimensions()
+
+
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_Image_pickle_raster(protocol):
+    array = np.arange(4 * 3 * 4, dtype=np.uint8).reshape((3, 4, 4))
+    array[:, :, 3] = 255
+    image = skia.Image(array)
+    obj = pickle.loads(pickle.dumps(image, protocol))
+    info = image.imageInfo()
+    expected = bytearray(info.computeMinByteSize())
+    actual = bytearray(info.computeMinByteSize())
+    image.readPixels(info, expected, info.minRowBytes())
+    obj.readPixels(info, actual, info.minRowBytes())
+    assert actual == expected
+
+
+@pytest.mark.skipif(
+    pickle.HIGHEST_PROTOCOL < 5, reason='requires pickle protocol 5')
+def test_Image_pickle_out_of_band():
+    image = skia.Image(np.zeros((64, 64, 4), dtype=np.uint8))
+    buffers = []
+    data = pickle.dumps(image, 5, buffer_callback=buffers.append)
+    assert len(buffers) == 1
+    assert len(data) < 1024
+    obj = pickle.loads(data, buffers=buffers)
+    assert obj.dimensions() == image.dimensions()
+
+
 def test_Image_makeTextureImage(image, context):
     assert isinstance(
         image.makeTextureImage(
@@ -137,6 +207,15 @@ def test_Image_makeWithFilter(image, context):
         skia.Image)
 
 
+def test_Image_makeWithFilterAsync(image, run_async):
+    async def make():
+        return await image.makeWithFilterAsync(skia.ImageFilters.Blur(1., 1.))
+    filtered, outSubset, offset = run_async(make())
+    assert isinstance(filtered, skia.Image)
+    assert isinstance(outSubset, skia.IRect)
+    assert isinstance(offset, skia.IPoint)
+
+
 def test_Image_asLegacyBitmap(image):
     bitmap = skia.Bitmap()
     assert isinstance(image.asLegacyBitmap(bitmap), bool)
@@ -188,6 +267,22 @@ def test_Image_MakeFromRaster(pixmap):
     assert isinstance(skia.Image.MakeFromRaster(pixmap), skia.Image)
 
 
+def test_Image_MakeFromShared():
+    shared_memory = pytest.importorskip('multiprocessing.shared_memory')
+    info = skia.ImageInfo.MakeN32Premul(16, 16)
+    shm = shared_memory.SharedMemory(
+        create=True, size=info.computeMinByteSize())
+    try:
+        shm.buf[:4] = b'\xff\xff\xff\xff'
+        image = skia.Image.MakeFromShared(shm.name, info)
+        assert isinstance(image, skia.Image)
+        assert image.width() == 16
+        del image
+    finally:
+        shm.close()
+        shm.unlink()
+
+
 def test_Image_MakeFromBitmap():
     bitmap = skia.Bitmap()
     bitmap.allocPixels(skia.ImageInfo().MakeN32Premul(100, 100))
@@ -202,6 +297,14 @@ def test_Image_DecodeToRaster(png_data):
     assert isinstance(skia.Image.DecodeToRaster(png_data), skia.Image)
 
 
+def test_Image_DecodeToRasterAsync(png_data, run_async):
+    async def decode(data):
+        return await skia.Image.DecodeToRasterAsync(data)
+    assert isinstance(run_async(decode(png_data)), skia.Image)
+    with pytest.raises(RuntimeError):
+        run_async(decode(b'invalid'))
+
+
 def test_Image_DecodeToTexture(context, png_data):
     assert isinstance(
         skia.Image.DecodeToTexture(context, png_data), skia.Image)
@@ -298,3 +401,33 @@ def test_Imag_MakeBackendTextureFromImage(context, image):
     assert isinstance(
         skia.Image.MakeBackendTextureFromImage(context, image, backendTexture),
         bool)
+
+
+def test_Image_array_interface():
+    pixels = np.random.randint(0, 256, (20, 30, 4), dtype=np.uint8)
+    image = skia.Image(pixels)
+    array = np.asarray(image)
+    assert array.shape == (20, 30, 4)
+    assert not array.flags.writeable
+
+
+def test_Image_dlpack():
+    image = skia.Image(np.zeros((20, 30, 4), dtype=np.uint8))
+    with pytest.raises(BufferError):
+        image.__dlpack__()
+    assert 'dltensor_versioned' in repr(image.__dlpack__(max_version=(1, 0)))
+    assert '"dltensor"' in repr(image.__dlpack__(copy=True))
+    with pytest.raises(BufferError):
+        image.__dlpack__(max_version=(1, 0), dl_device=(2, 0))
+    if hasattr(np, 'from_dlpack'):
+        try:
+            array = np.from_dlpack(image)
+        except BufferError:
+            pytest.skip('NumPy does not support DLPack 1.0')
+        assert array.shape == (20, 30, 4)
+        assert not array.flags.writeable
+
+
+def test_Image_array_interface_raises(png_data):
+    with pytest.raises(RuntimeError):
+        skia.Image.MakeFromEncoded(png_data).__array_interface__
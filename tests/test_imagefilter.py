@@ -1,5 +1,6 @@
 import skia
 import pytest
+import pickle
 
 
 @pytest.fixture
@@ -82,6 +83,12 @@ def test_ImageFilter_Deserialize(imagefilter):
         skia.ImageFilter)
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_ImageFilter_pickle(imagefilter, protocol):
+    obj = pickle.loads(pickle.dumps(imagefilter, protocol))
+    assert isinstance(obj, skia.ImageFilter)
+
+
 def test_AlphaThresholdFilter_Make():
     assert isinstance(
         skia.AlphaThresholdFilter.Make(
@@ -1,5 +1,6 @@
 import skia
 import pytest
+import pickle
 
 
 @pytest.fixture
@@ -35,6 +36,12 @@ def test_MaskFilter_Deserialize(maskfilter):
         skia.MaskFilter)
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_MaskFilter_pickle(maskfilter, protocol):
+    obj = pickle.loads(pickle.dumps(maskfilter, protocol))
+    assert isinstance(obj, skia.MaskFilter)
+
+
 def test_ShaderMaskFilter_Make():
     assert isinstance(
         skia.ShaderMaskFilter.Make(skia.Shaders.Empty()),
@@ -1,6 +1,7 @@
 import skia
 import pytest
 import numpy as np
+import pickle
 
 
 @pytest.fixture
@@ -156,6 +157,13 @@ def test_Matrix_set9(matrix):
     assert isinstance(matrix.set9([0, 0, 0, 0, 0, 0, 0, 0, 0]), skia.Matrix)
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_Matrix_pickle(protocol):
+    matrix = skia.Matrix.MakeAll(1, 2, 3, 4, 5, 6, 7, 8, 9)
+    obj = pickle.loads(pickle.dumps(matrix, protocol))
+    assert obj.get9() == matrix.get9()
+
+
 @pytest.mark.parametrize('args', [
     (0, 0,),
     (skia.Point(0, 0),),
@@ -1,5 +1,6 @@
 import skia
 import pytest
+import pickle
 
 
 @pytest.mark.parametrize('args', [
@@ -129,6 +130,21 @@ def test_Paint_getFillPath(paint, args):
     assert isinstance(paint.getFillPath(*args), bool)
 
 
+def test_Paint_getFillPaths():
+    paint = skia.Paint()
+    paint.setStyle(skia.Paint.kStroke_Style)
+    paint.setStrokeWidth(4)
+    paths = [skia.Path() for _ in range(40)]
+    for i, path in enumerate(paths):
+        path.moveTo(i, 0)
+        path.lineTo(i, 10)
+    results, bounds = paint.getFillPaths(paths, resScale=2)
+    assert len(results) == 40
+    assert bounds.shape == (40, 4)
+    assert tuple(bounds[3]) == (1, 0, 5, 10)
+    assert paint.getFillPaths([])[1].shape == (0, 4)
+
+
 def test_Paint_getShader(paint):
     assert isinstance(paint.getShader(), (skia.Shader, type(None)))
 
@@ -193,6 +209,19 @@ def test_Paint_getImageFilter(paint):
     assert isinstance(paint.getImageFilter(), (skia.ImageFilter, type(None)))
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_Paint_pickle(protocol):
+    paint = skia.Paint()
+    paint.setColor(0xFF00FF00)
+    paint.setStrokeWidth(3)
+    paint.setImageFilter(skia.ImageFilters.Blur(1.0, 1.0))
+    obj = pickle.loads(pickle.dumps(paint, protocol))
+    assert isinstance(obj, skia.Paint)
+    assert obj.getColor() == 0xFF00FF00
+    assert obj.getStrokeWidth() == 3
+    assert isinstance(obj.getImageFilter(), skia.ImageFilter)
+
+
 def test_Paint_refImageFilter(paint):
     assert isinstance(paint.refImageFilter(), (skia.ImageFilter, type(None)))
 
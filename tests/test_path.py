@@ -1,5 +1,7 @@
 import skia
 import pytest
+import numpy as np
+import pickle
 
 
 @pytest.fixture()
@@ -434,6 +436,15 @@ def test_Path_serialize(path):
     assert isinstance(path.serialize(), skia.Data)
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_Path_pickle(protocol):
+    path = skia.Path()
+    path.addCircle(10, 10, 5)
+    obj = pickle.loads(pickle.dumps(path, protocol))
+    assert isinstance(obj, skia.Path)
+    assert obj == path
+
+
 def test_Path_getGenerationID(path):
     assert isinstance(path.getGenerationID(), int)
 
@@ -463,9 +474,97 @@ def test_Path_ConvertConicToQuads(path):
         skia.Point(0, 0), skia.Point(0, 1), skia.Point(1, 1), 1, 1), list)
 
 
+@pytest.fixture
+def rects():
+    paths = []
+    for i in range(10):
+        p = skia.Path()
+        p.addRect(skia.Rect.MakeXYWH(i * 5, 0, 10, 10))
+        paths.append(p)
+    return paths
+
+
+def test_Path_Op(rects):
+    result = skia.Path.Op(rects[0], rects[1], skia.kUnion_PathOp)
+    assert result.getBounds() == skia.Rect(0, 0, 15, 10)
+
+
+def test_Path_Op_list(rects):
+    result = skia.Path.Op(rects, skia.kUnion_PathOp)
+    assert result.getBounds() == skia.Rect(0, 0, 55, 10)
+    assert skia.Path.Op([]).isEmpty()
+
+
+def test_Path_Simplify(rects):
+    path = skia.Path()
+    path.addPath(rects[0])
+    path.addPath(rects[1])
+    assert skia.Path.Simplify(path).countPoints() < path.countPoints()
+
+
+def test_Path_TightBounds(rects):
+    assert skia.Path.TightBounds(rects[1]) == skia.Rect(5, 0, 15, 10)
+
+
+def test_Path_AsWinding(rects):
+    path = skia.Path(rects[0])
+    path.setFillType(skia.PathFillType.kEvenOdd)
+    assert skia.Path.AsWinding(path).getFillType() == \
+        skia.PathFillType.kWinding
+
+
+def test_Path_FromSVGString():
+    path = skia.Path.FromSVGString('M0 0 L10 0 L10 10 Z')
+    assert path.getBounds() == skia.Rect(0, 0, 10, 10)
+    with pytest.raises(ValueError):
+        skia.Path.FromSVGString('M0 0 X')
+
+
+def test_Path_FromSVGStrings():
+    paths = skia.Path.FromSVGStrings(['M0 0 L10 10', 'invalid'] * 100)
+    assert len(paths) == 200
+    assert isinstance(paths[0], skia.Path)
+    assert paths[1] is None
+
+
+def test_Path_toSVGString(rects):
+    assert skia.Path.FromSVGString(rects[1].toSVGString()) == rects[1]
+
+
+def test_OpBuilder(rects):
+    builder = skia.OpBuilder()
+    builder.add(rects[0], skia.kUnion_PathOp)
+    builder.add(rects[1:], skia.kUnion_PathOp)
+    assert builder.resolve().getBounds() == skia.Rect(0, 0, 55, 10)
+
+
 def test_Path_eq(path):
     assert path == path
 
 
 def test_Path_ne(path):
     assert not (path != path)
+
+
+def test_Path_containsPoints():
+    path = skia.Path()
+    path.addRect(skia.Rect(10, 10, 20, 20))
+    points = np.array([[15, 15], [5, 5], [19, 11]], dtype=np.float32)
+    assert path.containsPoints(points).tolist() == [True, False, True]
+    points = np.random.uniform(0, 30, (10000, 2)).astype(np.float32)
+    expected = [path.contains(x, y) for x, y in points]
+    assert path.containsPoints(points).tolist() == expected
+    with pytest.raises(ValueError):
+        path.containsPoints(np.zeros((4, 3)))
+
+
+def test_PathSet_locate():
+    shapes = [skia.Path() for _ in range(3)]
+    shapes[0].addRect(skia.Rect(0, 0, 10, 10))
+    shapes[1].addRect(skia.Rect(20, 0, 30, 10))
+    shapes[2].addCircle(5, 5, 2)
+    paths = skia.PathSet(shapes)
+    assert len(paths) == 3
+    assert isinstance(paths[-1], skia.Path)
+    points = np.array([[1, 1], [25, 5], [5, 5], [15, 5]])
+    assert paths.locate(points).tolist() == [0, 1, 2, -1]
@@ -1,5 +1,6 @@
 import skia
 import pytest
+import pickle
 
 
 @pytest.fixture
@@ -166,6 +167,16 @@ def test_PathEffect_filterPath(patheffect):
     assert isinstance(patheffect.filterPath(dst, src, rec, None), bool)
 
 
+def test_PathEffect_filterPaths(patheffect):
+    paths = [skia.Path() for _ in range(3)]
+    for path in paths:
+        path.addCircle(10, 10, 5)
+    results, bounds = patheffect.filterPaths(paths)
+    assert len(results) == 3
+    assert all(isinstance(path, skia.Path) for path in results)
+    assert bounds.shape == (3, 4)
+
+
 def test_PathEffect_computeFastBounds(patheffect):
     patheffect.computeFastBounds(skia.Rect(100, 100), skia.Rect(100, 100))
 
@@ -192,6 +203,12 @@ def test_PathEffect_Deserialize(patheffect):
     assert isinstance(effect, skia.PathEffect)
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_PathEffect_pickle(patheffect, protocol):
+    obj = pickle.loads(pickle.dumps(patheffect, protocol))
+    assert isinstance(obj, skia.PathEffect)
+
+
 def test_PathEffect_GetFlattenableType():
     assert isinstance(
         skia.PathEffect.GetFlattenableType(), skia.Flattanable.Type)
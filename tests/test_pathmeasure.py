@@ -0,0 +1,93 @@
+import skia
+import pytest
+import numpy as np
+
+
+@pytest.fixture
+def line():
+    path = skia.Path()
+    path.moveTo(0, 0)
+    path.lineTo(100, 0)
+    path.moveTo(0, 10)
+    path.lineTo(0, 60)
+    return path
+
+
+@pytest.fixture
+def pathmeasure(line):
+    return skia.PathMeasure(line)
+
+
+def test_PathMeasure_init(line):
+    assert isinstance(skia.PathMeasure(), skia.PathMeasure)
+    assert isinstance(skia.PathMeasure(line, True, 2), skia.PathMeasure)
+
+
+def test_PathMeasure_setPath(pathmeasure, line):
+    pathmeasure.setPath(line, False)
+    pathmeasure.setPath(None)
+    assert pathmeasure.getLength() == 0
+
+
+def test_PathMeasure_getLength(pathmeasure):
+    assert pathmeasure.getLength() == 100
+
+
+def test_PathMeasure_getPosTan(pathmeasure):
+    position, tangent = pathmeasure.getPosTan(25)
+    assert position == skia.Point(25, 0)
+    assert tangent == skia.Point(1, 0)
+    assert skia.PathMeasure().getPosTan(0) is None
+
+
+def test_PathMeasure_getPosTan_array(pathmeasure):
+    positions, tangents = pathmeasure.getPosTan(np.array([0, 50, 100]))
+    assert positions.shape == (3, 2)
+    assert tangents.shape == (3, 2)
+    assert np.allclose(positions[:, 0], [0, 50, 100])
+    assert np.allclose(tangents, [[1, 0]] * 3)
+    positions, _ = skia.PathMeasure().getPosTan([0, 1])
+    assert np.isnan(positions).all()
+
+
+def test_PathMeasure_getMatrix(pathmeasure):
+    assert isinstance(pathmeasure.getMatrix(10), skia.Matrix)
+    assert isinstance(pathmeasure.getMatrix(
+        10, skia.PathMeasure.kGetPosition_MatrixFlag), skia.Matrix)
+
+
+def test_PathMeasure_getSegment(pathmeasure):
+    segment = pathmeasure.getSegment(10, 20)
+    assert segment.getBounds() == skia.Rect(10, 0, 20, 0)
+    assert pathmeasure.getSegment(20, 20) is None
+
+
+def test_PathMeasure_isClosed(pathmeasure):
+    assert not pathmeasure.isClosed()
+
+
+def test_PathMeasure_nextContour(pathmeasure):
+    assert pathmeasure.nextContour()
+    assert pathmeasure.getLength() == 50
+    assert not pathmeasure.nextContour()
+
+
+def test_ContourMeasureIter(line):
+    contours = list(skia.ContourMeasureIter(line))
+    assert [c.length() for c in contours] == [100, 50]
+
+
+def test_ContourMeasureIter_next(line):
+    it = skia.ContourMeasureIter(line, False, 1)
+    assert isinstance(it.next(), skia.ContourMeasure)
+    assert isinstance(it.next(), skia.ContourMeasure)
+    assert it.next() is None
+
+
+def test_ContourMeasure_getPosTan(line):
+    contour = skia.ContourMeasureIter(line).next()
+    positions, tangents = contour.getPosTan(np.linspace(0, 100, 5))
+    assert np.allclose(positions[:, 0], [0, 25, 50, 75, 100])
+    assert isinstance(contour.getMatrix(10), skia.Matrix)
+    assert isinstance(contour.getSegment(0, 10), skia.Path)
+    assert not contour.isClosed()
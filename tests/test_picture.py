@@ -1,5 +1,7 @@
 import skia
 import pytest
+import numpy as np
+import pickle
 
 
 @pytest.fixture
@@ -15,6 +17,75 @@ def test_Picture_playback(picture, canvas):
     picture.playback(canvas)
 
 
+def test_Picture_playbackRegion():
+    recorder = skia.PictureRecorder()
+    recorder.beginRecording(skia.Rect(100, 100)).clear(skia.ColorRED)
+    picture = recorder.finishRecordingAsPicture()
+    surface = skia.Surface(100, 100)
+    picture.playbackRegion(
+        surface.getCanvas(), skia.Region(skia.IRect(0, 0, 10, 10)))
+    array = np.asarray(surface)
+    assert np.all(array[:10, :10, 3] == 255)
+    assert np.all(array[10:, :, 3] == 0)
+
+
+def test_Picture_playbackAsync(picture, run_async):
+    surface = skia.Surface(100, 100)
+
+    async def playback():
+        return await picture.playbackAsync(surface)
+    assert run_async(playback()) is surface
+
+
+def test_Picture_playback_threads(picture):
+    from concurrent.futures import ThreadPoolExecutor
+
+    def render(_):
+        surface = skia.Surface(100, 100)
+        picture.playback(surface.getCanvas())
+        return bytes(surface.makeImageSnapshot().encodeToData())
+
+    expected = render(None)
+    with ThreadPoolExecutor(4) as executor:
+        assert all(r == expected for r in executor.map(render, range(16)))
+
+
+def test_Picture_profile(picture, canvas):
+    stats = picture.profile(canvas, 1)
+    assert isinstance(stats, dict)
+    assert isinstance(stats['ops'], list)
+    assert all(op['count'] > 0 for op in stats['ops'])
+    assert len(stats['top']) <= 1
+
+
+def test_Picture_profile_vertices():
+    recorder = skia.PictureRecorder()
+    canvas = recorder.beginRecording(skia.Rect(100, 100))
+    vertices = skia.Vertices(skia.Vertices.kTriangles_VertexMode, [
+        (skia.Point(0, 0), skia.Point(0, 0), 0xFFFF0000),
+        (skia.Point(50, 0), skia.Point(0, 0), 0xFFFF0000),
+        (skia.Point(0, 50), skia.Point(0, 0), 0xFFFF0000),
+    ])
+    canvas.drawVertices(vertices, skia.Paint())
+    picture = recorder.finishRecordingAsPicture()
+    stats = picture.profile(skia.Surface(100, 100).getCanvas())
+    assert [op['op'] for op in stats['ops']] == ['drawVertices']
+
+
+def test_Picture_profile_translated():
+    recorder = skia.PictureRecorder()
+    recorder.beginRecording(skia.Rect(100, 100)).drawRect(
+        skia.Rect(10, 10), skia.Paint())
+    picture = recorder.finishRecordingAsPicture()
+    surface = skia.Surface(100, 100)
+    canvas = surface.getCanvas()
+    canvas.translate(20, 30)
+    stats = picture.profile(canvas)
+    assert stats['ops'][0]['bounds'] == skia.Rect(20, 30, 30, 40)
+    assert np.asarray(surface)[35, 25, 3] == 255
+    assert np.asarray(surface)[5, 5, 3] == 0
+
+
 def test_Picture_cullRect(picture):
     assert isinstance(picture.cullRect(), skia.Rect)
 
@@ -46,6 +117,13 @@ def test_Picture_MakeFromData(picture):
         skia.Picture.MakeFromData(picture.serialize()), skia.Picture)
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_Picture_pickle(picture, protocol):
+    obj = pickle.loads(pickle.dumps(picture, protocol))
+    assert isinstance(obj, skia.Picture)
+    assert obj.cullRect() == picture.cullRect()
+
+
 def test_Picture_MakePlaceholder():
     assert isinstance(
         skia.Picture.MakePlaceholder(skia.Rect(100, 100)), skia.Picture)
@@ -1,5 +1,6 @@
 import skia
 import pytest
+import numpy as np
 
 
 @pytest.mark.parametrize('args', [
@@ -116,6 +117,13 @@ def test_Pixmap_addr32(pixmap):
     assert isinstance(pixmap.addr32(), memoryview)
 
 
+def test_Pixmap_addr32_shape():
+    info = skia.ImageInfo.MakeN32Premul(30, 20)
+    data = bytearray(info.computeMinByteSize())
+    pixmap = skia.Pixmap(info, data, info.minRowBytes())
+    assert pixmap.addr32().shape == (20, 30)
+
+
 def test_Pixmap_addr64(pixmap):
     info = skia.ImageInfo.Make(
         100, 100, skia.ColorType.kRGBA_F16_ColorType,
@@ -148,3 +156,35 @@ def test_Pixmap_scalePixels(pixmap):
 
 def test_Pixmap_erase(pixmap):
     assert isinstance(pixmap.erase(0xFFFFFFFF), bool)
+
+
+@pytest.mark.parametrize('ct, dtype, channels', [
+    (skia.kAlpha_8_ColorType, np.uint8, 1),
+    (skia.kRGBA_8888_ColorType, np.uint8, 4),
+    (skia.kRGB_565_ColorType, np.uint16, 1),
+    (skia.kRGBA_F16_ColorType, np.float16, 4),
+    (skia.kRGBA_F32_ColorType, np.float32, 4),
+])
+def test_Pixmap_array_interface(ct, dtype, channels):
+    info = skia.ImageInfo.Make(30, 20, ct, skia.kPremul_AlphaType)
+    data = bytearray(info.computeMinByteSize())
+    pixmap = skia.Pixmap(info, data, info.minRowBytes())
+    array = np.asarray(pixmap)
+    assert array.shape == (20, 30, channels)
+    assert array.dtype == dtype
+    array[1, 2] = 1
+    assert np.frombuffer(data, dtype)[channels * (30 + 2)] == 1
+
+
+def test_Pixmap_array_interface_raises():
+    with pytest.raises(RuntimeError):
+        skia.Pixmap().__array_interface__
+
+
+def test_Pixmap_dlpack(pixmap):
+    assert pixmap.__dlpack_device__() == (1, 0)
+    if not hasattr(np, 'from_dlpack'):
+        pytest.skip('NumPy does not support DLPack')
+    array = np.from_dlpack(pixmap)
+    assert array.shape == (100, 100, 4)
+    assert np.shares_memory(array, np.asarray(pixmap))
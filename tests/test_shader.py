@@ -1,5 +1,6 @@
 import skia
 import pytest
+import pickle
 
 
 @pytest.fixture
@@ -35,6 +36,12 @@ def test_Shader_makeWithColorFilter(shader):
         shader.makeWithColorFilter(skia.LumaColorFilter.Make()), skia.Shader)
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_Shader_pickle(shader, protocol):
+    obj = pickle.loads(pickle.dumps(shader, protocol))
+    assert isinstance(obj, skia.Shader)
+
+
 def test_Shaders_Empty():
     assert isinstance(skia.Shaders.Empty(), skia.Shader)
 
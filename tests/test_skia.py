@@ -30,3 +30,37 @@ def test_skia():
     image = surface.makeImageSnapshot()
     data = image.encodeToData()
     encoded = bytes(data)
+
+
+@pytest.mark.parametrize('name', [
+    'Font', 'TextBlob', 'Picture', 'PictureRecorder', 'Vertices', 'DrawList'])
+def test_skia_lazy_names(name):
+    assert name in dir(skia)
+    assert isinstance(getattr(skia, name), type)
+
+
+def test_skia_missing_name():
+    with pytest.raises(AttributeError):
+        skia.NoSuchName
+
+
+def test_skia_eager_import():
+    import os
+    import subprocess
+    import sys
+    env = dict(os.environ, SKIA_PYTHON_EAGER_IMPORT='1')
+    code = (
+        'import skia\n'
+        'names = ["Font", "TextBlob", "Picture", "PictureRecorder", '
+        '"Vertices", "DrawList", "Document", "PDF", "SurfacePool", '
+        '"PathMeasure"]\n'
+        'assert all(name in vars(skia) for name in names)\n')
+    subprocess.check_call([sys.executable, '-c', code], env=env)
+
+
+def test_skia_star_import():
+    namespace = {}
+    exec('from skia import *', namespace)
+    for name in ('Font', 'TextBlob', 'Picture', 'PictureRecorder',
+                 'PathMeasure', 'Document', 'SurfacePool', 'Surface'):
+        assert name in namespace
@@ -0,0 +1,35 @@
+import skia
+import pytest
+import io
+
+
+def test_WStream_init():
+    f = io.BytesIO()
+    stream = skia.WStream(f)
+    assert stream.write(b'abc')
+    stream.flush()
+    assert stream.bytesWritten() == 3
+    assert f.getvalue() == b'abc'
+
+
+def test_WStream_init_invalid():
+    with pytest.raises(TypeError):
+        skia.WStream(object())
+
+
+def test_FILEWStream(tmpdir):
+    path = str(tmpdir.join('output.bin'))
+    stream = skia.FILEWStream(path)
+    assert stream.isValid()
+    assert stream.write(b'abc')
+    stream.flush()
+    del stream
+    with open(path, 'rb') as f:
+        assert f.read() == b'abc'
+
+
+def test_DynamicMemoryWStream():
+    stream = skia.DynamicMemoryWStream()
+    assert stream.write(b'abc')
+    assert stream.bytesWritten() == 3
+    assert bytes(stream.detachAsData()) == b'abc'
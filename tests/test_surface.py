@@ -115,6 +115,53 @@ def test_Surface_MakeRasterDirect(args):
     check_surface(skia.Surface.MakeRasterDirect(*args))
 
 
+def test_Surface_MakeRasterShared():
+    shared_memory = pytest.importorskip('multiprocessing.shared_memory')
+    info = skia.ImageInfo.MakeN32Premul(16, 16)
+    shm = shared_memory.SharedMemory(
+        create=True, size=info.computeMinByteSize())
+    try:
+        surface = skia.Surface.MakeRasterShared(info, shm.name)
+        check_surface(surface)
+        surface.getCanvas().clear(0xFFFFFFFF)
+        del surface
+        assert bytes(shm.buf[:4]) == b'\xff\xff\xff\xff'
+    finally:
+        shm.close()
+        shm.unlink()
+
+
+def test_Surface_MakeRasterShared_child_process():
+    import subprocess
+    shared_memory = pytest.importorskip('multiprocessing.shared_memory')
+    info = skia.ImageInfo.MakeN32Premul(16, 16)
+    shm = shared_memory.SharedMemory(
+        create=True, size=info.computeMinByteSize())
+    try:
+        code = (
+            'import skia\n'
+            'info = skia.ImageInfo.MakeN32Premul(16, 16)\n'
+            'surface = skia.Surface.MakeRasterShared(info, %r)\n'
+            'surface.getCanvas().clear(0xFFFFFFFF)\n' % shm.name)
+        result = subprocess.run(
+            [sys.executable, '-c', code], stderr=subprocess.PIPE, check=True)
+        assert b'leaked' not in result.stderr
+        attached = shared_memory.SharedMemory(shm.name)
+        assert bytes(attached.buf[:4]) == b'\xff\xff\xff\xff'
+        attached.close()
+    finally:
+        shm.close()
+        shm.unlink()
+
+
+def test_Surface_MakeRasterShared_buffer():
+    info = skia.ImageInfo.MakeN32Premul(16, 16)
+    with pytest.raises(RuntimeError):
+        skia.Surface.MakeRasterShared(info, bytearray(16))
+    check_surface(skia.Surface.MakeRasterShared(
+        info, bytearray(info.computeMinByteSize())))
+
+
 @pytest.mark.parametrize('args', [
     (skia.ImageInfo.MakeN32Premul(16, 16),),
     (skia.ImageInfo.MakeN32Premul(16, 16), 16 * 4),
@@ -127,6 +174,13 @@ def test_Surface_MakeRaster(args):
     check_surface(skia.Surface.MakeRaster(*args))
 
 
+def test_Surface_MakeRaster_allocator():
+    surface = skia.Surface.MakeRaster(
+        skia.ImageInfo.MakeN32Premul(320, 240),
+        allocator=skia.PixelAllocator.MakeArena())
+    check_surface(surface)
+
+
 @pytest.mark.parametrize('args', [
     (320, 240),
     (320, 240, skia.SurfaceProps(skia.SurfaceProps.kLegacyFontHost_InitType)),
@@ -152,3 +206,59 @@ def test_Surface_MakeRenderTarget(args, context):
 
 def test_Surface_MakeNull():
     check_surface(skia.Surface.MakeNull(100, 100))
+
+
+def test_Surface_array_interface():
+    surface = skia.Surface(32, 24)
+    surface.getCanvas().clear(skia.ColorWHITE)
+    snapshot = surface.makeImageSnapshot()
+    array = np.asarray(surface)
+    assert array.shape == (surface.height(), surface.width(), 4)
+    array[:] = 0
+    assert np.all(np.asarray(snapshot) == 255)
+
+
+def test_Surface_dlpack():
+    if not hasattr(np, 'from_dlpack'):
+        pytest.skip('NumPy does not support DLPack')
+    array = np.from_dlpack(skia.Surface(32, 24))
+    assert array.shape == (24, 32, 4)
+
+
+def test_Surface_takeDamage():
+    surface = skia.Surface(100, 100)
+    with pytest.raises(RuntimeError):
+        surface.takeDamage()
+    surface.setDamageTracking(True)
+    canvas = surface.getDamageCanvas()
+    canvas.drawRect(skia.Rect(10, 10, 20, 20), skia.Paint())
+    damage = surface.takeDamage()
+    assert isinstance(damage, skia.Region)
+    assert damage.contains(skia.IRect(10, 10, 20, 20))
+    assert not damage.contains(50, 50)
+    assert surface.takeDamage().isEmpty()
+    surface.setDamageTracking(False)
+    canvas.drawPaint(skia.Paint())
+    assert surface.takeDamage().isEmpty()
+
+
+def test_Surface_takeDamage_drawBitmap():
+    surface = skia.Surface(100, 100)
+    surface.setDamageTracking(True)
+    bitmap = skia.Bitmap()
+    bitmap.allocN32Pixels(10, 10)
+    surface.getDamageCanvas().drawBitmap(bitmap, 30, 40)
+    damage = surface.takeDamage()
+    assert damage.contains(skia.IRect(30, 40, 40, 50))
+    assert not damage.contains(60, 60)
+
+
+def test_Surface_getDamageCanvas():
+    surface = skia.Surface(100, 100)
+    with pytest.raises(RuntimeError):
+        surface.getDamageCanvas()
+    surface.setDamageTracking(True)
+    assert surface.getDamageCanvas() is not surface.getCanvas()
+    assert surface.getCanvas().getSurface() is not None
+    surface.getCanvas().drawRect(skia.Rect(10, 10, 20, 20), skia.Paint())
+    assert surface.takeDamage().isEmpty()
@@ -0,0 +1,78 @@
+import skia
+import pytest
+import numpy as np
+
+
+@pytest.fixture
+def pool():
+    return skia.SurfacePool(skia.ImageInfo.MakeN32Premul(32, 24), maxCached=1)
+
+
+def test_SurfacePool_init(pool):
+    assert isinstance(pool, skia.SurfacePool)
+    assert pool.info().width() == 32
+
+
+def test_SurfacePool_init_raises():
+    with pytest.raises(ValueError):
+        skia.SurfacePool(skia.ImageInfo.MakeN32Premul(0, 0))
+
+
+def test_SurfacePool_acquire(pool):
+    with pool.acquire() as lease:
+        assert isinstance(lease, skia.SurfacePool.Lease)
+        assert isinstance(lease.surface, skia.Surface)
+    with pool.acquire() as lease:
+        pass
+    stats = pool.stats()
+    assert stats['allocated'] == 1
+    assert stats['reused'] == 1
+    assert stats['released'] == 2
+    assert stats['cached'] == 1
+    assert stats['outstanding'] == 0
+
+
+def test_SurfacePool_release_erases(pool):
+    lease = pool.acquire()
+    canvas = lease.surface.getCanvas()
+    canvas.translate(4, 4)
+    canvas.clipRect(skia.Rect(0, 0, 8, 8))
+    canvas.clear(skia.ColorRED)
+    snapshot = lease.surface.makeImageSnapshot()
+    lease.dirty = skia.IRect(4, 4, 12, 12)
+    lease.release()
+    with pool.acquire() as lease:
+        surface = lease.surface
+        assert not np.asarray(surface).any()
+        assert surface.getCanvas().getTotalMatrix().isIdentity()
+        assert surface.getCanvas().getDeviceClipBounds() == skia.IRect(32, 24)
+    assert np.asarray(snapshot)[4, 4].any()
+
+
+def test_SurfacePool_discard(pool):
+    leases = [pool.acquire(), pool.acquire()]
+    for lease in leases:
+        lease.release()
+    lease.release()
+    stats = pool.stats()
+    assert stats['discarded'] == 1
+    assert stats['cached'] == 1
+    pool.purge()
+    assert pool.stats()['cached'] == 0
+
+
+def test_SurfacePool_Lease_released(pool):
+    lease = pool.acquire()
+    lease.release()
+    with pytest.raises(RuntimeError):
+        lease.surface
+
+
+def test_SurfacePool_Lease_dirty_in_with(pool):
+    with pool.acquire() as lease:
+        lease.surface.getCanvas().clear(skia.ColorRED)
+        lease.dirty = skia.IRect(4, 4, 12, 12)
+    with pool.acquire() as lease:
+        array = np.asarray(lease.surface)
+        assert not array[4:12, 4:12].any()
+        assert array[0, 0].all()
@@ -1,5 +1,6 @@
 import skia
 import pytest
+import pickle
 
 
 @pytest.fixture
@@ -66,6 +67,13 @@ def test_TexbBlob_Deserialize(textblob):
     assert isinstance(skia.TextBlob.Deserialize(data), skia.TextBlob)
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_TextBlob_pickle(textblob, protocol):
+    obj = pickle.loads(pickle.dumps(textblob, protocol))
+    assert isinstance(obj, skia.TextBlob)
+    assert obj.bounds() == textblob.bounds()
+
+
 def test_TextBlob_Iter_init(textblob):
     assert isinstance(skia.TextBlob.Iter(textblob), skia.TextBlob.Iter)
 